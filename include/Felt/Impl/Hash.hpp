@@ -0,0 +1,225 @@
+#ifndef INCLUDE_FELT_IMPL_HASH_HPP_
+#define INCLUDE_FELT_IMPL_HASH_HPP_
+
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <Felt/Impl/Common.hpp>
+
+namespace Felt
+{
+namespace Impl
+{
+namespace Hash
+{
+
+/**
+ * Small open-addressing (linear probing) hash map from position index to list index.
+ *
+ * Keys and values are stored as 32-bit integers, so an entry takes 8 bytes. Capacity is kept at a
+ * power of two and at most half full, so memory (and the cost of `clear`) is proportional to the
+ * number of entries rather than to the size of the grid the keys index into.
+ */
+class Map
+{
+private:
+	/// Storage type for keys and values.
+	using Int = std::uint32_t;
+	/// Marker for an empty slot.
+	static constexpr Int s_empty = std::numeric_limits<Int>::max();
+	/// Smallest (non-zero) capacity.
+	static constexpr ListIdx s_capacity_min = 16;
+
+	/// A key-value pair.
+	struct Entry
+	{
+		Int key;
+		Int value;
+	};
+
+	/// Slots, each either empty or holding an entry.
+	std::vector<Entry>	m_entries;
+	/// Number of (non-empty) entries.
+	ListIdx				m_size;
+	/// Shift to take the high bits of a hash, giving an index into slots.
+	Int					m_shift;
+
+public:
+	/**
+	 * Construct an empty map, without allocating.
+	 */
+	Map() : m_size{0}, m_shift{0}
+	{}
+
+	/**
+	 * Get the value stored for a key.
+	 *
+	 * @param key_ key to look up.
+	 * @return stored value, or null_idx if not present.
+	 */
+	ListIdx get(const PosIdx key_) const
+	{
+		if (!m_size)
+			return Felt::null_idx;
+
+		const ListIdx slot_idx = find(Int(key_));
+		if (m_entries[slot_idx].key == s_empty)
+			return Felt::null_idx;
+		return m_entries[slot_idx].value;
+	}
+
+	/**
+	 * Store a value for a key, or remove the key if the value is null_idx.
+	 *
+	 * @param key_ key to store against.
+	 * @param value_ value to store.
+	 */
+	void set(const PosIdx key_, const ListIdx value_)
+	{
+		if (value_ == Felt::null_idx)
+		{
+			erase(key_);
+			return;
+		}
+
+		if (key_ >= s_empty || value_ >= s_empty)
+		{
+			std::stringstream sstr;
+			sstr << "Hash map key " << key_ << " or value " << value_ <<
+				" too large for 32-bit storage";
+			std::string str = sstr.str();
+			throw std::domain_error(str);
+		}
+
+		if (2 * (m_size + 1) > m_entries.size())
+			grow();
+
+		const ListIdx slot_idx = find(Int(key_));
+		if (m_entries[slot_idx].key == s_empty)
+		{
+			m_entries[slot_idx].key = Int(key_);
+			m_size++;
+		}
+		m_entries[slot_idx].value = Int(value_);
+	}
+
+	/**
+	 * Remove a key (if present).
+	 *
+	 * Subsequent entries in the probe sequence are shifted back to fill the gap, so no tombstones
+	 * are required.
+	 *
+	 * @param key_ key to remove.
+	 */
+	void erase(const PosIdx key_)
+	{
+		if (!m_size)
+			return;
+
+		const ListIdx mask = m_entries.size() - 1;
+		ListIdx slot_idx = find(Int(key_));
+		if (m_entries[slot_idx].key == s_empty)
+			return;
+
+		for (ListIdx slot_idx_next = (slot_idx + 1) & mask;
+			m_entries[slot_idx_next].key != s_empty;
+			slot_idx_next = (slot_idx_next + 1) & mask
+		) {
+			const ListIdx slot_idx_home = home(m_entries[slot_idx_next].key);
+			// Move entry back if the gap lies between its home slot and its current slot.
+			if (((slot_idx_next - slot_idx_home) & mask) >= ((slot_idx_next - slot_idx) & mask))
+			{
+				m_entries[slot_idx] = m_entries[slot_idx_next];
+				slot_idx = slot_idx_next;
+			}
+		}
+
+		m_entries[slot_idx].key = s_empty;
+		m_size--;
+	}
+
+	/**
+	 * Remove all entries without deallocating.
+	 */
+	void clear()
+	{
+		if (m_size)
+			m_entries.assign(m_entries.size(), Entry{s_empty, s_empty});
+		m_size = 0;
+	}
+
+	/**
+	 * Remove all entries and deallocate.
+	 */
+	void deallocate()
+	{
+		m_entries = std::vector<Entry>{};
+		m_size = 0;
+		m_shift = 0;
+	}
+
+	/**
+	 * Get number of entries.
+	 *
+	 * @return number of keys stored.
+	 */
+	ListIdx size() const
+	{
+		return m_size;
+	}
+
+private:
+	/**
+	 * Get the preferred slot of a key (Fibonacci hashing).
+	 *
+	 * @param key_ key to hash.
+	 * @return index of slot.
+	 */
+	ListIdx home(const Int key_) const
+	{
+		return ListIdx(Int(key_ * 2654435769u) >> m_shift);
+	}
+
+	/**
+	 * Find the slot holding a key, or the empty slot that terminates its probe sequence.
+	 *
+	 * @param key_ key to search for.
+	 * @return index of slot.
+	 */
+	ListIdx find(const Int key_) const
+	{
+		const ListIdx mask = m_entries.size() - 1;
+		ListIdx slot_idx = home(key_);
+		while (m_entries[slot_idx].key != s_empty && m_entries[slot_idx].key != key_)
+			slot_idx = (slot_idx + 1) & mask;
+		return slot_idx;
+	}
+
+	/**
+	 * Double capacity (or allocate the minimum) and re-insert existing entries.
+	 */
+	void grow()
+	{
+		std::vector<Entry> entries(
+			m_entries.size() ? 2 * m_entries.size() : s_capacity_min, Entry{s_empty, s_empty}
+		);
+		std::swap(entries, m_entries);
+
+		m_shift = 32;
+		for (ListIdx capacity = m_entries.size(); capacity > 1; capacity >>= 1)
+			m_shift--;
+
+		for (const Entry& entry : entries)
+			if (entry.key != s_empty)
+				m_entries[find(entry.key)] = entry;
+	}
+};
+
+} // Hash.
+} // Impl.
+} // Felt.
+
+#endif /* INCLUDE_FELT_IMPL_HASH_HPP_ */
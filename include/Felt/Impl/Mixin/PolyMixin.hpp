@@ -1,6 +1,12 @@
 #ifndef INCLUDE_FELT_IMPL_MIXIN_POLYMIXIN_HPP_
 #define INCLUDE_FELT_IMPL_MIXIN_POLYMIXIN_HPP_
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
 #include <Felt/Impl/Common.hpp>
 #include <Felt/Impl/Lookup.hpp>
 #include <Felt/Impl/Mixin/PartitionedMixin.hpp>
@@ -10,6 +16,61 @@ namespace Felt
 {
 namespace Impl
 {
+namespace Poly
+{
+
+/**
+ * Strategy for choosing which cubes to polygonise.
+ */
+enum class March
+{
+	/// Visit every cube whose lower corner is tracked in any narrow band layer.
+	all,
+	/**
+	 * Visit only (narrow band) cubes that have a zero-layer point as a corner, since only these
+	 * can contain a zero-crossing.
+	 */
+	zero,
+	/**
+	 * Visit only cubes that have a corner marked as changed since the last march, patching the
+	 * existing polygonisation in place. Falls back to `all` if there is no existing
+	 * polygonisation to patch.
+	 */
+	dirty
+};
+
+/**
+ * Policy for calculating vertex normals (3D only).
+ */
+enum class Normals
+{
+	/// Never store normals. Each call to `norm` recalculates the normal.
+	none,
+	/// Calculate normals as vertices are created during a march.
+	eager,
+	/// Calculate normals on first call to `norm` and store them.
+	lazy
+};
+
+/**
+ * Half-open range `[begin, end)` of slots in a vertex or simplex array.
+ *
+ * Multiply by the size of the element type to get a byte range.
+ */
+struct Span
+{
+	/// First slot in range.
+	ListIdx begin;
+	/// One past the last slot in range.
+	ListIdx end;
+};
+
+/// List of ranges of slots.
+using Spans = std::vector<Span>;
+
+} // Poly.
+
+
 namespace Mixin
 {
 namespace Poly
@@ -52,6 +113,17 @@ struct Geom<TDerived, 2>
 			this->pos = pos.template cast<Distance>();
 		}
 
+		/**
+		 * Create a new vertex at position pos.
+		 *
+		 * @param pos
+		 */
+		template <typename Pos>
+		explicit Vertex(const Pos& pos)
+		{
+			this->pos = pos.template cast<Distance>();
+		}
+
 		/**
 		 * Create an uninitialised vertex.
 		 */
@@ -147,6 +219,20 @@ struct Geom<TDerived, 3> {
 			this->norm.normalize();
 		}
 
+		/**
+		 * Create a vertex at position pos, without calculating the normal.
+		 *
+		 * The normal is set to NaN to flag that it has not been calculated.
+		 *
+		 * @param pos
+		 */
+		template <typename Pos>
+		explicit Vertex(const Pos& pos)
+		{
+			this->pos = pos.template cast<Distance>();
+			this->norm = Vec3f::Constant(std::numeric_limits<Distance>::quiet_NaN());
+		}
+
 		/**
 		 * Create an uninitialised vertex.
 		 */
@@ -671,6 +757,1535 @@ const short Geom<TDerived, 3>::vtx_order [][16] = {
 	{-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}
 };
 
+
+/**
+ * Polygonisation of a single spatial partition of an isogrid using marching squares/cubes.
+ *
+ * Storage of the vertex cache (the index of the vertex along each cube edge) and the index of the
+ * first simplex generated by each cube is deferred to the derived class, which must provide:
+ *
+ * - `ListIdx vtx_idx(const VecDi& pos, Dim axis) const` and
+ *   `void vtx_idx(const VecDi& pos, Dim axis, ListIdx idx)`, to get and set (null_idx to clear)
+ *   the index of the vertex along the edge starting at `pos` along `axis`.
+ * - `ListIdx spx_idx(PosIdx pos_idx) const` and `void spx_idx(PosIdx pos_idx, ListIdx idx)`, to
+ *   get and set (null_idx to clear) the index of the first simplex generated by a cube.
+ *
+ * For level of detail, the isogrid can be sampled at a coarser `stride`, where cubes span
+ * `stride` grid nodes along each axis. Cracks between partitions polygonised at different strides
+ * are hidden by skirts: boundary edges (or endpoints, in 2D) lying on a face of the partition are
+ * extruded into the surface, within the plane of that face.
+ *
+ * @tparam TDerived CRTP derived class.
+ */
+template <class TDerived>
+class Polygonise
+{
+private:
+	/// Traits of derived class.
+	using Traits = Impl::Traits<TDerived>;
+	/// Small epsilon value within which we consider vertex position as "exact".
+	static constexpr Distance epsilon = std::numeric_limits<Distance>::epsilon();
+	/// Dimension of isogrid to polygonise.
+	static constexpr Dim t_dims = Traits::t_dims;
+
+	using GeomImpl = Geom<TDerived>;
+
+	/// Strategy for choosing which cubes to polygonise.
+	using March = Impl::Poly::March;
+	/// Policy for calculating vertex normals.
+	using Normals = Impl::Poly::Normals;
+	/// Isogrid to (partially) polygonise.
+	using IsoGrid = typename Traits::IsoGrid;
+	/// Spatial partition type this poly will be responsible for.
+	using IsoChild = typename IsoGrid::Child;
+	/// Lookup grid of spatial partition this poly will be responsible for.
+	using IsoLookup = typename IsoChild::Lookup;
+	/// Integer vector.
+	using VecDi = Felt::VecDi<t_dims>;
+	/// Float vector.
+	using VecDf = Felt::VecDf<t_dims>;
+	/// Cube edge type.
+	using Edge = typename GeomImpl::Edge;
+	/// Vertex type.
+	using Vertex = typename GeomImpl::Vertex;
+	/// Simplex type.
+	using Simplex = typename GeomImpl::Simplex;
+	/// Vertex array type for vertex storage.
+	using VtxArray = std::vector<Vertex>;
+	/// Simplex array type for simplex storage.
+	using SpxArray = std::vector<Simplex>;
+	/// Range of slots in a vertex or simplex array.
+	using Span = Impl::Poly::Span;
+	/// List of ranges of slots in a vertex or simplex array.
+	using Spans = Impl::Poly::Spans;
+
+	/// Isogrid to (partially) polygonise.
+	const IsoGrid*			m_pisogrid;
+	/// Lookup grid of isogrid spatial partition giving positions to march over.
+	const IsoLookup*		m_pisolookup;
+
+	/// List of interpolated vertices.
+	VtxArray	m_a_vtx;
+	/// List of simplexes (i.e. lines for 2D or triangles for 3D).
+	SpxArray	m_a_spx;
+	/// Buffer of (de-duplicated) cube positions to polygonise, reused between marches.
+	PosIdxList	m_pos_idxs_cube;
+	/// Edge along which each vertex lies (see `vtx_edges`), or null_idx if slot is released.
+	PosIdxList	m_edge_idxs_vtx;
+	/// Next simplex generated by the same cube, for each simplex, or null_idx if none.
+	std::vector<ListIdx>	m_spx_idxs_next;
+	/// Position index of the cube that generated each simplex, or null_idx if slot is released.
+	PosIdxList	m_pos_idxs_spx;
+	/// Simplex slots available for reuse.
+	std::vector<ListIdx>	m_spx_idxs_free;
+	/// Vertex slots available for reuse.
+	std::vector<ListIdx>	m_vtx_idxs_free;
+	/// Position indices of isogrid points changed since the last march.
+	PosIdxList	m_pos_idxs_dirty;
+	/// Whether a complete polygonisation exists that can be patched by a `dirty` march.
+	bool		m_is_marched;
+	/// Policy for calculating vertex normals.
+	Normals		m_normals;
+	/// Existing vertex slots overwritten during the current march.
+	std::vector<ListIdx>	m_vtx_idxs_changed;
+	/// Existing simplex slots overwritten during the current march.
+	std::vector<ListIdx>	m_spx_idxs_changed;
+	/// Size of vertex array at the start of the current march.
+	ListIdx		m_vtx_idx_append;
+	/// Size of simplex array at the start of the current march.
+	ListIdx		m_spx_idx_append;
+	/// Ranges of vertex slots written by the last march.
+	Spans		m_vtx_spans;
+	/// Ranges of simplex slots written by the last march.
+	Spans		m_spx_spans;
+	/// Number of grid nodes spanned by each cube along each axis, i.e. level of detail.
+	NodeIdx		m_stride;
+	/// Skirt vertex hanging from each vertex into each axis-aligned face, reused between marches.
+	std::vector<ListIdx>	m_vtx_idxs_skirt;
+
+protected:
+	/**
+	 * Construct a polygonisation of (part of) an isogrid.
+	 *
+	 * @param isogrid_ grid to be (partially) polygonised.
+	 * @param normals_ policy for calculating vertex normals.
+	 */
+	Polygonise(const IsoGrid& isogrid_, const Normals normals_) :
+		m_pisogrid{&isogrid_}, m_pisolookup{nullptr}, m_is_marched{false}, m_normals{normals_},
+		m_vtx_idx_append{0}, m_spx_idx_append{0}, m_stride{1}
+	{}
+
+	/**
+	 * Destroy the vertex and simplex arrays.
+	 */
+	void deactivate()
+	{
+		reset();
+		m_a_vtx.shrink_to_fit();
+		m_a_spx.shrink_to_fit();
+		m_edge_idxs_vtx.shrink_to_fit();
+		m_spx_idxs_next.shrink_to_fit();
+		m_pos_idxs_spx.shrink_to_fit();
+		m_vtx_idxs_skirt.clear();
+		m_vtx_idxs_skirt.shrink_to_fit();
+	}
+
+	/**
+	 * Clear the vertex and simplex arrays without deallocating.
+	 *
+	 * The derived class is responsible for clearing its vertex cache, but simplex indices of cubes
+	 * are cleared here.
+	 */
+	void reset()
+	{
+		for (const PosIdx pos_idx_cube : m_pos_idxs_spx)
+			if (pos_idx_cube != Felt::null_idx)
+				pself->spx_idx(pos_idx_cube, Felt::null_idx);
+		m_a_vtx.resize(0);
+		m_a_spx.resize(0);
+		m_edge_idxs_vtx.resize(0);
+		m_spx_idxs_next.resize(0);
+		m_pos_idxs_spx.resize(0);
+		m_spx_idxs_free.resize(0);
+		m_vtx_idxs_free.resize(0);
+		m_pos_idxs_dirty.resize(0);
+		m_is_marched = false;
+		m_vtx_idxs_changed.resize(0);
+		m_spx_idxs_changed.resize(0);
+		m_vtx_idx_append = 0;
+		m_spx_idx_append = 0;
+		m_vtx_spans.resize(0);
+		m_spx_spans.resize(0);
+	}
+
+	/**
+	 * Update the polygonisation from the stored pointer to isogrid child lookup.
+	 *
+	 * A polygonisation at a coarser stride cannot be patched, so is always rebuilt from scratch,
+	 * whatever the strategy.
+	 *
+	 * @param march_ strategy for choosing which cubes to polygonise.
+	 */
+	void march(const March march_ = March::all)
+	{
+		if (m_stride > 1 && march_ != March::all)
+			pself->reset();
+
+		m_vtx_idxs_changed.clear();
+		m_spx_idxs_changed.clear();
+		m_vtx_idx_append = m_a_vtx.size();
+		m_spx_idx_append = m_a_spx.size();
+
+		if (m_stride > 1)
+		{
+			march_stride();
+			skirts();
+		}
+		else switch (march_)
+		{
+		case March::zero:
+			march_zero();
+			break;
+		case March::dirty:
+			march_dirty();
+			break;
+		default:
+			for (TupleIdx list_idx = 0; list_idx < m_pisolookup->num_lists; list_idx++)
+			{
+				for (PosIdx pos_idx_leaf : m_pisolookup->list(list_idx))
+				{
+					spx(m_pisolookup->index(pos_idx_leaf));
+				}
+			}
+		}
+		m_pos_idxs_dirty.clear();
+		m_is_marched = true;
+
+		spans(m_vtx_idxs_changed, m_vtx_idx_append, m_a_vtx.size(), m_vtx_spans);
+		spans(m_spx_idxs_changed, m_spx_idx_append, m_a_spx.size(), m_spx_spans);
+	}
+
+	/**
+	 * Mark an isogrid point as changed, so that a `dirty` march will re-polygonise the cubes
+	 * that have it as a corner.
+	 *
+	 * Ignored if the point is outside of this partition or it is not active.
+	 *
+	 * @param pos_ position of changed isogrid point.
+	 * @return whether the point was recorded.
+	 */
+	bool dirty(const VecDi& pos_)
+	{
+		if (!pself->is_active() || !pself->inside(pos_))
+			return false;
+		m_pos_idxs_dirty.push_back(pself->index(pos_));
+		return true;
+	}
+
+	/**
+	 * Force the next `dirty` march to re-polygonise the whole partition.
+	 */
+	void invalidate()
+	{
+		m_is_marched = false;
+	}
+
+	/**
+	 * Set the level of detail, as the number of grid nodes spanned by each cube along each axis.
+	 *
+	 * Takes effect on the next march. Changing the stride invalidates the polygonisation.
+	 *
+	 * @param stride_ stride between sampled grid nodes, which must divide the partition size.
+	 */
+	void stride(const NodeIdx stride_)
+	{
+		const VecDi& child_size = m_pisogrid->child_size();
+		for (Dim axis = 0; axis < t_dims; axis++)
+		{
+			if (stride_ < 1 || child_size(axis) % stride_ != 0)
+			{
+				std::stringstream sstr;
+				sstr << "Stride " << stride_ << " does not divide partition size " <<
+					Felt::format(child_size);
+				std::string str = sstr.str();
+				throw std::domain_error(str);
+			}
+		}
+
+		if (stride_ == m_stride)
+			return;
+		m_stride = stride_;
+		m_is_marched = false;
+	}
+
+	/**
+	 * Get the level of detail.
+	 *
+	 * @return number of grid nodes spanned by each cube along each axis.
+	 */
+	NodeIdx stride() const
+	{
+		return m_stride;
+	}
+
+	/**
+	 * Bind this Poly to the given Lookup grid giving positions to march over.
+	 *
+	 * I.e. a child spatial partition of the isogrid.
+	 *
+	 * @param pisolookup
+	 */
+	void bind(const IsoLookup& isolookup)
+	{
+		m_pisolookup = &isolookup;
+	}
+
+	/**
+	 * Bind this Poly to a (copy of the) isogrid and a Lookup grid within it giving positions to
+	 * march over.
+	 *
+	 * @param isogrid_ grid to be (partially) polygonised.
+	 * @param isolookup_ lookup grid of spatial partition of isogrid_.
+	 */
+	void bind(const IsoGrid& isogrid_, const IsoLookup& isolookup_)
+	{
+		m_pisogrid = &isogrid_;
+		m_pisolookup = &isolookup_;
+	}
+
+	/**
+	 * Get a pointer to the isogrid child's lookup grid that gives points to polygonise.
+	 *
+	 * @return lookup grid to iterate over.
+	 */
+	IsoLookup const* bind() const
+	{
+		return m_pisolookup;
+	}
+
+	/**
+	 * Get the vertex array.
+	 *
+	 * @return
+	 */
+	const VtxArray& vtxs() const
+	{
+		return m_a_vtx;
+	}
+
+	/**
+	 * Get the array of simplices.
+	 *
+	 * @return
+	 */
+	const SpxArray& spxs() const
+	{
+		return m_a_spx;
+	}
+
+	/**
+	 * Get the ranges of vertex slots written by the last march.
+	 *
+	 * Slots outside of these ranges hold the same vertex as before the last march, so only these
+	 * ranges need be re-uploaded to e.g. a GPU buffer. Released vertex slots are not referenced by
+	 * any simplex, so are not reported.
+	 *
+	 * @return sorted, non-overlapping list of slot ranges.
+	 */
+	const Spans& vtx_spans() const
+	{
+		return m_vtx_spans;
+	}
+
+	/**
+	 * Get the ranges of simplex slots written by the last march.
+	 *
+	 * Slots outside of these ranges (and below `spxs().size()`) hold the same simplex as before
+	 * the last march. If the array shrank, then the tail beyond `spxs().size()` is discarded.
+	 *
+	 * @return sorted, non-overlapping list of slot ranges.
+	 */
+	const Spans& spx_spans() const
+	{
+		return m_spx_spans;
+	}
+
+	/**
+	 * Get the normal of a vertex (3D only).
+	 *
+	 * Depending on the normals policy, the normal is either the one calculated during the march
+	 * (`eager`), calculated and stored on first call (`lazy`) or recalculated on every call
+	 * (`none`).
+	 *
+	 * @param vtx_idx_ index of vertex.
+	 * @return unit normal of vertex.
+	 */
+	VecDf norm(const ListIdx vtx_idx_)
+	{
+		Vertex& vtx = m_a_vtx[vtx_idx_];
+
+		switch (m_normals)
+		{
+		case Normals::none:
+			return Vertex(m_pisogrid, vtx.pos).norm;
+		case Normals::lazy:
+			if (std::isnan(vtx.norm(0)))
+				vtx.norm = Vertex(m_pisogrid, vtx.pos).norm;
+			return vtx.norm;
+		default:
+			return vtx.norm;
+		}
+	}
+
+	/**
+	 * Get the edge along which each vertex lies.
+	 *
+	 * Edges are encoded as `pos_idx * D + axis`, see `edge_pos` and `edge_axis`.
+	 *
+	 * @return edge index for each vertex, or null_idx for vertex slots that have been released.
+	 */
+	const PosIdxList& vtx_edges() const
+	{
+		return m_edge_idxs_vtx;
+	}
+
+	/**
+	 * Get the lower endpoint of an edge.
+	 *
+	 * @param edge_idx_ encoded edge index.
+	 * @return position of lower endpoint of edge.
+	 */
+	VecDi edge_pos(const PosIdx edge_idx_) const
+	{
+		return pself->index(edge_idx_ / t_dims);
+	}
+
+	/**
+	 * Get the axis along which an edge lies.
+	 *
+	 * @param edge_idx_ encoded edge index.
+	 * @return axis of edge.
+	 */
+	static Dim edge_axis(const PosIdx edge_idx_)
+	{
+		return Dim(edge_idx_ % t_dims);
+	}
+
+private:
+	/**
+	 * Polygonise only those cubes that have a zero-layer point as a corner.
+	 *
+	 * A cube is owned by the partition containing its lower corner, so cubes touching zero-layer
+	 * points in this partition or in the neighbouring partitions along the positive axes are
+	 * gathered, de-duplicated, then polygonised. Cubes whose lower corner is not in the narrow band
+	 * are skipped, for consistency with a full march.
+	 */
+	void march_zero()
+	{
+		// Index of zero-layer tracking list.
+		static constexpr TupleIdx layer_idx_zero = IsoLookup::num_lists / 2;
+		// Number of corners of a cube, which is also the number of partitions sharing a corner.
+		static constexpr PosIdx num_corners = 1 << t_dims;
+
+		const VecDi& pos_lower = m_pisolookup->offset();
+		const VecDi& pos_upper = pos_lower + m_pisolookup->size();
+		const VecDi& pos_child = m_pisogrid->pos_child(pos_lower);
+
+		m_pos_idxs_cube.clear();
+
+		for (PosIdx corner_idx_child = 0; corner_idx_child < num_corners; corner_idx_child++)
+		{
+			VecDi pos_child_neigh = pos_child;
+			for (Dim axis = 0; axis < t_dims; axis++)
+				pos_child_neigh(axis) += NodeIdx((corner_idx_child >> axis) & 1);
+
+			if (!Felt::inside(
+				pos_child_neigh, m_pisogrid->children().offset(),
+				VecDi{m_pisogrid->children().offset() + m_pisogrid->children().size()}
+			))
+				continue;
+
+			const IsoChild& isochild = m_pisogrid->children().get(pos_child_neigh);
+
+			for (const PosIdx pos_idx_leaf : isochild.lookup().list(layer_idx_zero))
+			{
+				const VecDi& pos_leaf = isochild.index(pos_idx_leaf);
+
+				// Only points on the face of a neighbouring partition that abuts this partition can
+				// be a corner of a cube owned by this partition.
+				bool is_boundary = true;
+				for (Dim axis = 0; is_boundary && axis < t_dims; axis++)
+					if ((corner_idx_child >> axis) & 1)
+						is_boundary = pos_leaf(axis) == pos_upper(axis);
+				if (!is_boundary)
+					continue;
+
+				// Cubes that have this zero-layer point as a corner.
+				for (PosIdx corner_idx = 0; corner_idx < num_corners; corner_idx++)
+				{
+					VecDi pos_cube = pos_leaf;
+					for (Dim axis = 0; axis < t_dims; axis++)
+						pos_cube(axis) -= NodeIdx((corner_idx >> axis) & 1);
+
+					if (!Felt::inside(pos_cube, pos_lower, pos_upper))
+						continue;
+
+					const PosIdx pos_idx_cube = m_pisolookup->index(pos_cube);
+
+					if (m_pisolookup->get(pos_idx_cube) == Felt::null_idx)
+						continue;
+
+					m_pos_idxs_cube.push_back(pos_idx_cube);
+				}
+			}
+		}
+
+		std::sort(m_pos_idxs_cube.begin(), m_pos_idxs_cube.end());
+		m_pos_idxs_cube.erase(
+			std::unique(m_pos_idxs_cube.begin(), m_pos_idxs_cube.end()), m_pos_idxs_cube.end()
+		);
+
+		for (const PosIdx pos_idx_cube : m_pos_idxs_cube)
+			spx(m_pisolookup->index(pos_idx_cube));
+	}
+
+	/**
+	 * Polygonise cubes spanning `stride` grid nodes along each axis.
+	 *
+	 * Cubes have their lower corner a multiple of the stride from the isogrid offset, so that they
+	 * tile partitions exactly. A cube is visited if any narrow band point lies within it. Cubes
+	 * extending beyond the isogrid are skipped.
+	 */
+	void march_stride()
+	{
+		const VecDi& pos_lower = m_pisogrid->offset();
+		const VecDi& pos_upper = pos_lower + m_pisogrid->size();
+
+		m_pos_idxs_cube.clear();
+
+		for (TupleIdx list_idx = 0; list_idx < m_pisolookup->num_lists; list_idx++)
+		{
+			for (const PosIdx pos_idx_leaf : m_pisolookup->list(list_idx))
+			{
+				VecDi pos_cube = m_pisolookup->index(pos_idx_leaf);
+				for (Dim axis = 0; axis < t_dims; axis++)
+					pos_cube(axis) -= (pos_cube(axis) - pos_lower(axis)) % m_stride;
+
+				if (!Felt::inside(VecDi{pos_cube + VecDi::Constant(m_stride)}, pos_lower, pos_upper))
+					continue;
+
+				m_pos_idxs_cube.push_back(pself->index(pos_cube));
+			}
+		}
+
+		std::sort(m_pos_idxs_cube.begin(), m_pos_idxs_cube.end());
+		m_pos_idxs_cube.erase(
+			std::unique(m_pos_idxs_cube.begin(), m_pos_idxs_cube.end()), m_pos_idxs_cube.end()
+		);
+
+		for (const PosIdx pos_idx_cube : m_pos_idxs_cube)
+			spx(pself->index(pos_idx_cube));
+	}
+
+	/**
+	 * Append skirts along the boundary of the partition.
+	 *
+	 * Each simplex face (an edge in 3D, an endpoint in 2D) lying on a face of the partition is
+	 * extruded by one stride into the surface, within the plane of the partition face. Skirt
+	 * vertices are not along any edge, so have a `vtx_edges` entry of null_idx, and skirt
+	 * simplices are not owned by any cube.
+	 */
+	void skirts()
+	{
+		// Number of vertices in a face of a simplex.
+		static constexpr Dim num_face_vtxs = t_dims - 1;
+
+		const VecDi& pos_lower = m_pisolookup->offset();
+		const VecDi& pos_upper = pos_lower + m_pisolookup->size();
+		const ListIdx num_spxs = m_a_spx.size();
+
+		m_vtx_idxs_skirt.assign(m_a_vtx.size() * t_dims, Felt::null_idx);
+
+		for (ListIdx spx_idx = 0; spx_idx < num_spxs; spx_idx++)
+		{
+			for (Dim endpoint = 0; endpoint < t_dims; endpoint++)
+			{
+				for (Dim axis = 0; axis < t_dims; axis++)
+				{
+					for (const NodeIdx bound : {pos_lower(axis), pos_upper(axis)})
+					{
+						bool is_boundary = true;
+						for (Dim face_vtx = 0; face_vtx < num_face_vtxs; face_vtx++)
+						{
+							const ListIdx vtx_idx =
+								m_a_spx[spx_idx].idxs((endpoint + face_vtx) % t_dims);
+							is_boundary &= m_a_vtx[vtx_idx].pos(axis) == Distance(bound);
+						}
+						if (is_boundary)
+							skirt(spx_idx, endpoint, axis);
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * Append a skirt hanging from a face of a simplex.
+	 *
+	 * Skirt simplices are wound to match the simplex they hang from, i.e. in 3D the edge `a->b`
+	 * gives triangles `b,a,a'` and `b,a',b'`, and in 2D a line segment `a->b` gives `a',a` at its
+	 * start and `b,b'` at its end.
+	 *
+	 * @param spx_idx_ index of simplex.
+	 * @param endpoint_ first vertex of face within simplex.
+	 * @param axis_ normal axis of the partition face that the simplex face lies on.
+	 */
+	void skirt(const ListIdx spx_idx_, const Dim endpoint_, const Dim axis_)
+	{
+		const ListIdx vtx_idx_a = m_a_spx[spx_idx_].idxs(endpoint_);
+		const ListIdx vtx_idx_a_skirt = skirt_vtx(vtx_idx_a, axis_);
+		Simplex simplex;
+
+		if (t_dims == 2)
+		{
+			simplex.idxs(endpoint_) = vtx_idx_a;
+			simplex.idxs(1 - endpoint_) = vtx_idx_a_skirt;
+			push_spx(simplex);
+			return;
+		}
+
+		const ListIdx vtx_idx_b = m_a_spx[spx_idx_].idxs((endpoint_ + 1) % t_dims);
+		const ListIdx vtx_idx_b_skirt = skirt_vtx(vtx_idx_b, axis_);
+
+		simplex.idxs(0) = vtx_idx_b;
+		simplex.idxs(1) = vtx_idx_a;
+		simplex.idxs(t_dims - 1) = vtx_idx_a_skirt;
+		push_spx(simplex);
+		simplex.idxs(1) = vtx_idx_a_skirt;
+		simplex.idxs(t_dims - 1) = vtx_idx_b_skirt;
+		push_spx(simplex);
+	}
+
+	/**
+	 * Lookup, or calculate then store, the skirt vertex hanging from a vertex on a partition face.
+	 *
+	 * The skirt vertex is displaced by one stride against the gradient projected into the plane
+	 * of the face, i.e. into the surface. It keeps the normal of the vertex it hangs from.
+	 *
+	 * @param vtx_idx_ index of vertex on partition face.
+	 * @param axis_ normal axis of the partition face.
+	 * @return index of skirt vertex.
+	 */
+	ListIdx skirt_vtx(const ListIdx vtx_idx_, const Dim axis_)
+	{
+		ListIdx& vtx_idx_skirt = m_vtx_idxs_skirt[vtx_idx_ * t_dims + axis_];
+		if (vtx_idx_skirt != Felt::null_idx)
+			return vtx_idx_skirt;
+
+		Vertex vtx = m_a_vtx[vtx_idx_];
+		VecDf dir = m_pisogrid->grad(vtx.pos);
+		dir(axis_) = 0;
+		const Distance len = dir.norm();
+		if (len > epsilon)
+			vtx.pos -= dir * (Distance(m_stride) / len);
+
+		vtx_idx_skirt = m_a_vtx.size();
+		m_a_vtx.push_back(vtx);
+		m_edge_idxs_vtx.push_back(Felt::null_idx);
+		return vtx_idx_skirt;
+	}
+
+	/**
+	 * Append a simplex that is not generated by any cube.
+	 *
+	 * @param simplex_ simplex to append.
+	 */
+	void push_spx(const Simplex& simplex_)
+	{
+		m_a_spx.push_back(simplex_);
+		m_spx_idxs_next.push_back(Felt::null_idx);
+		m_pos_idxs_spx.push_back(Felt::null_idx);
+	}
+
+	/**
+	 * Patch the polygonisation, re-polygonising only cubes that have a changed point as a corner.
+	 *
+	 * Cached vertices along edges touching a changed point are recalculated in place, or released
+	 * for reuse if the edge no longer crosses the zero-curve. Simplices of affected cubes are
+	 * released, then the cubes are re-polygonised, reusing released simplex slots. Finally any
+	 * remaining gaps in the simplex array are filled from the end of the array.
+	 *
+	 * Released vertex slots remain in the vertex array (unreferenced) until reused or until the
+	 * next full march.
+	 */
+	void march_dirty()
+	{
+		// Number of corners of a cube.
+		static constexpr PosIdx num_corners = 1 << t_dims;
+
+		if (!m_is_marched)
+		{
+			pself->reset();
+			march(March::all);
+			return;
+		}
+
+		std::sort(m_pos_idxs_dirty.begin(), m_pos_idxs_dirty.end());
+		m_pos_idxs_dirty.erase(
+			std::unique(m_pos_idxs_dirty.begin(), m_pos_idxs_dirty.end()), m_pos_idxs_dirty.end()
+		);
+
+		// Recalculate or release vertices along edges that have a changed point as an endpoint.
+		for (const PosIdx pos_idx_dirty : m_pos_idxs_dirty)
+		{
+			const VecDi& pos_dirty = pself->index(pos_idx_dirty);
+
+			for (Dim axis = 0; axis < t_dims; axis++)
+			{
+				for (NodeIdx dir = -1; dir <= 0; dir++)
+				{
+					VecDi pos_a = pos_dirty;
+					pos_a(axis) += dir;
+
+					const ListIdx vtx_idx = pself->vtx_idx(pos_a, axis);
+					if (vtx_idx == Felt::null_idx)
+						continue;
+
+					VecDi pos_b = pos_a;
+					pos_b(axis) += 1;
+
+					if ((m_pisogrid->get(pos_a) > 0) != (m_pisogrid->get(pos_b) > 0))
+					{
+						m_a_vtx[vtx_idx] = vtx(pos_a, axis);
+						m_vtx_idxs_changed.push_back(vtx_idx);
+					}
+					else
+					{
+						m_vtx_idxs_free.push_back(vtx_idx);
+						m_edge_idxs_vtx[vtx_idx] = Felt::null_idx;
+						pself->vtx_idx(pos_a, axis, Felt::null_idx);
+					}
+				}
+			}
+		}
+
+		// Gather cubes within the isogrid partition that have a changed point as a corner.
+		const VecDi& pos_lower = m_pisolookup->offset();
+		const VecDi& pos_upper = pos_lower + m_pisolookup->size();
+
+		m_pos_idxs_cube.clear();
+
+		for (const PosIdx pos_idx_dirty : m_pos_idxs_dirty)
+		{
+			const VecDi& pos_dirty = pself->index(pos_idx_dirty);
+
+			for (PosIdx corner_idx = 0; corner_idx < num_corners; corner_idx++)
+			{
+				VecDi pos_cube = pos_dirty;
+				for (Dim axis = 0; axis < t_dims; axis++)
+					pos_cube(axis) -= NodeIdx((corner_idx >> axis) & 1);
+
+				if (Felt::inside(pos_cube, pos_lower, pos_upper))
+					m_pos_idxs_cube.push_back(pself->index(pos_cube));
+			}
+		}
+
+		std::sort(m_pos_idxs_cube.begin(), m_pos_idxs_cube.end());
+		m_pos_idxs_cube.erase(
+			std::unique(m_pos_idxs_cube.begin(), m_pos_idxs_cube.end()), m_pos_idxs_cube.end()
+		);
+
+		// Release simplices of affected cubes.
+		for (const PosIdx pos_idx_cube : m_pos_idxs_cube)
+		{
+			ListIdx spx_idx = pself->spx_idx(pos_idx_cube);
+			while (spx_idx != Felt::null_idx)
+			{
+				m_spx_idxs_free.push_back(spx_idx);
+				m_pos_idxs_spx[spx_idx] = Felt::null_idx;
+				spx_idx = m_spx_idxs_next[spx_idx];
+			}
+			pself->spx_idx(pos_idx_cube, Felt::null_idx);
+		}
+
+		// Re-polygonise affected cubes that are (still) in the narrow band.
+		for (const PosIdx pos_idx_cube : m_pos_idxs_cube)
+		{
+			const VecDi& pos_cube = pself->index(pos_idx_cube);
+			if (m_pisolookup->get(m_pisolookup->index(pos_cube)) != Felt::null_idx)
+				spx(pos_cube);
+		}
+
+		compact();
+	}
+
+	/**
+	 * Fill gaps left by released simplex slots by moving simplices from the end of the array.
+	 */
+	void compact()
+	{
+		// Fill lowest gaps first, so that gaps at the end of the array can simply be dropped.
+		std::sort(m_spx_idxs_free.begin(), m_spx_idxs_free.end());
+
+		for (const ListIdx spx_idx_free : m_spx_idxs_free)
+		{
+			// Drop released slots from the end of the array.
+			while (m_a_spx.size() && m_pos_idxs_spx.back() == Felt::null_idx)
+				pop_spx();
+
+			if (spx_idx_free >= m_a_spx.size())
+				break;
+
+			// Move last simplex into the gap, relinking the chain of the cube that generated it.
+			const ListIdx spx_idx_last = m_a_spx.size() - 1;
+			const PosIdx pos_idx_cube = m_pos_idxs_spx[spx_idx_last];
+
+			ListIdx spx_idx = pself->spx_idx(pos_idx_cube);
+			if (spx_idx == spx_idx_last)
+			{
+				pself->spx_idx(pos_idx_cube, spx_idx_free);
+			}
+			else
+			{
+				while (m_spx_idxs_next[spx_idx] != spx_idx_last)
+					spx_idx = m_spx_idxs_next[spx_idx];
+				m_spx_idxs_next[spx_idx] = spx_idx_free;
+			}
+
+			m_a_spx[spx_idx_free] = m_a_spx[spx_idx_last];
+			m_spx_idxs_changed.push_back(spx_idx_free);
+			m_spx_idxs_next[spx_idx_free] = m_spx_idxs_next[spx_idx_last];
+			m_pos_idxs_spx[spx_idx_free] = pos_idx_cube;
+			pop_spx();
+		}
+
+		m_spx_idxs_free.clear();
+	}
+
+	/**
+	 * Merge overwritten and appended slots into a list of contiguous ranges.
+	 *
+	 * @param idxs_changed_ existing slots overwritten (sorted in place).
+	 * @param idx_append_ size of array before appending.
+	 * @param size_ current size of array.
+	 * @param spans_ list of ranges to populate.
+	 */
+	static void spans(
+		std::vector<ListIdx>& idxs_changed_, const ListIdx idx_append_, const ListIdx size_,
+		Spans& spans_
+	) {
+		const ListIdx idx_end = idx_append_ < size_ ? idx_append_ : size_;
+
+		std::sort(idxs_changed_.begin(), idxs_changed_.end());
+		spans_.clear();
+
+		for (const ListIdx idx : idxs_changed_)
+		{
+			// Slots beyond the end may have been dropped, slots beyond the append point are
+			// covered by the appended range.
+			if (idx >= idx_end)
+				break;
+			if (spans_.size() && spans_.back().end >= idx)
+				spans_.back().end = idx + 1;
+			else
+				spans_.push_back(Span{idx, idx + 1});
+		}
+
+		if (idx_end < size_)
+		{
+			if (spans_.size() && spans_.back().end == idx_end)
+				spans_.back().end = size_;
+			else
+				spans_.push_back(Span{idx_end, size_});
+		}
+	}
+
+	/**
+	 * Remove the last simplex slot.
+	 */
+	void pop_spx()
+	{
+		m_a_spx.pop_back();
+		m_spx_idxs_next.pop_back();
+		m_pos_idxs_spx.pop_back();
+	}
+
+	/**
+	 * Generate simplex(es) for isogrid grid at position pos.
+	 *
+	 * @param pos
+	 * @param m_isogrid
+	 */
+	void spx(const VecDi& pos)
+	{
+		// TODO: this is here for consistency only, since the marching
+		// cubes implementation marches in the negative z-axis, but
+		// positive x and y axes. Hence an offset is required so that the
+		// negative z-axis marching is compensated by shifting the
+		// calculation in the +z direction by one grid node.
+		// (NOTE: has no effect for 2D).
+		const VecDi pos_calc = pos - GeomImpl::SpxGridPosOffset * m_stride;
+		// Position index of cube, for tracking the simplices it generates.
+		const PosIdx pos_idx_cube = pself->index(pos);
+
+		// Get corner inside-outside bitmask at this position.
+		const unsigned short mask = this->mask(pos_calc);
+		// Array of indices of zero-crossing vertices along each axis from
+		// this corner.
+		unsigned vtx_idxs[GeomImpl::num_edges];
+		// Look up the edges that are crossed from the corner mask.
+		unsigned short vtx_mask = GeomImpl::vtx_mask[mask];
+		const short* vtx_order = GeomImpl::vtx_order[mask];
+
+		// Cube corners are all inside or all outside.
+		if (vtx_order[0] == -1)
+			return;
+
+		// Loop over each crossed edge in the cube, looking up
+		// (or calculating, if unavailable) the vertices at the
+		// zero-crossing.
+		for (ListIdx edge_idx = 0; edge_idx < GeomImpl::num_edges; edge_idx++ )
+		{
+			// Check if current edge is crossed by the zero curve.
+			if ((vtx_mask >> edge_idx) & 1)
+			{
+				const Edge& edge = GeomImpl::edges[edge_idx];
+				// Edges are defined as an axis and an offset.
+				// Look up index of vertex along current edge.
+				vtx_idxs[edge_idx] = unsigned(idx(pos_calc + edge.offset * m_stride, edge.axis));
+			}
+		}
+
+		// Check for degenerates. Compare every calculated vertex to every
+		// other to ensure they are not located on top of one-another.
+		// E.g. corners that lie at precisely zero will have D vertices that
+		// all lie on that corner.
+		// TODO: can't just throw away all triangles like this - others may
+		// be valid - must do a per-simplex degenerate check. Maybe not
+		// worth it, though.
+//			for (UINT edge_idx1 = 0; edge_idx1 < PolyBase<D>::num_edges - 1;
+//				edge_idx1++
+//			) {
+//				for (UINT edge_idx2 = edge_idx1+1;
+//					edge_idx2 < PolyBase<D>::num_edges; edge_idx2++)
+//				{
+//					// Check both edges are bisected by the zero-curve.
+//					if (!(((vtx_mask >> edge_idx1) & 1)
+//						&& ((vtx_mask >> edge_idx2) & 1)))
+//						continue;
+//
+//					// Get the position vector component of the vertex
+//					// information for both edges.
+//					const VecDf& pos1 = this->vtx(vtx_idxs[edge_idx1]).pos;
+//					const VecDf& pos2 = this->vtx(vtx_idxs[edge_idx2]).pos;
+//					const FLOAT dist = (pos1 - pos2).squaredNorm();
+//					// If they are essentially the same vertex,
+//					// then there is no simplex for this cube.
+//					if (dist <= This::epsilon())
+//						return;
+//				}
+//			}
+
+		// Join the vertices along each edge that the surface crosses to
+		// make a simplex (or simplices).
+		// The vtx_order lookup translates corner in-out mask to CCW
+		// vertex ordering. We take D elements at a time from the lookup,
+		// with each successive subset of D elements forming the next
+		// simplex.
+		for (ListIdx order_idx = 0; vtx_order[order_idx] != -1; order_idx += t_dims )
+		{
+			Simplex simplex;
+			// A simplex for number of dimensions D has D vertices,
+			// i.e. D endpoints.
+			for (Dim endpoint = 0; endpoint < t_dims; endpoint++)
+			{
+				// Each vertex of the simplex is stored as an index
+				// reference into the 'global' vertex array.
+				simplex.idxs(endpoint) = vtx_idxs[ vtx_order[order_idx+ListIdx(endpoint)] ];
+			}
+			// Append the simplex to the list of simplices that make up the
+			// polygonisation of this grid location, reusing a released slot if possible.
+			ListIdx spx_idx;
+			if (m_spx_idxs_free.size())
+			{
+				spx_idx = m_spx_idxs_free.back();
+				m_spx_idxs_free.pop_back();
+				m_a_spx[spx_idx] = std::move(simplex);
+				m_spx_idxs_changed.push_back(spx_idx);
+			}
+			else
+			{
+				spx_idx = m_a_spx.size();
+				m_a_spx.push_back(std::move(simplex));
+				m_spx_idxs_next.push_back(Felt::null_idx);
+				m_pos_idxs_spx.push_back(Felt::null_idx);
+			}
+			m_spx_idxs_next[spx_idx] = pself->spx_idx(pos_idx_cube);
+			m_pos_idxs_spx[spx_idx] = pos_idx_cube;
+			pself->spx_idx(pos_idx_cube, spx_idx);
+		}
+	} // End spx.
+
+
+	/**
+	 * Lookup, or calculate then store, and return the index into the vertex
+	 * array of a vertex at the zero-crossing of isogrid at pos_a along axis.
+	 *
+	 * @return
+	 */
+	ListIdx idx(const VecDi& pos_a, const Dim axis)
+	{
+		// Check lookup to see if vertex has already been calculated.
+		const ListIdx idx_lookup = pself->vtx_idx(pos_a, axis);
+		if (idx_lookup != Felt::null_idx) {
+			return idx_lookup;
+		}
+
+		// Append newly created vertex to the cache (reusing a released slot if possible) and
+		// return its index.
+		ListIdx idx;
+		if (m_vtx_idxs_free.size())
+		{
+			idx = m_vtx_idxs_free.back();
+			m_vtx_idxs_free.pop_back();
+			m_a_vtx[idx] = vtx(pos_a, axis);
+			m_vtx_idxs_changed.push_back(idx);
+		}
+		else
+		{
+			idx = m_a_vtx.size();
+			m_a_vtx.push_back(vtx(pos_a, axis));
+			m_edge_idxs_vtx.push_back(Felt::null_idx);
+		}
+		m_edge_idxs_vtx[idx] = pself->index(pos_a) * t_dims + axis;
+		pself->vtx_idx(pos_a, axis, idx);
+		return idx;
+	}
+
+	/**
+	 * Calculate vertex at the zero-crossing of isogrid along the edge starting at pos_a
+	 * along axis, spanning one stride.
+	 *
+	 * @return
+	 */
+	Vertex vtx(const VecDi& pos_a, const Dim axis) const
+	{
+		// Position of opposite endpoint.
+		VecDi pos_b(pos_a);
+		pos_b(axis) += m_stride;
+
+		// Value of isogrid at each endpoint of this edge.
+		const Distance val_a = m_pisogrid->get(pos_a);
+		const Distance val_b = m_pisogrid->get(pos_b);
+
+		// The newly created vertex.
+		Vertex vtx;
+
+		// Check if lies very close to an endpoint or midpoint, if so then no need (and possibly
+		// dangerous) to interpolate.
+		if (std::abs(val_a) <= epsilon) {
+			vtx = vertex(pos_a);
+		} else if (std::abs(val_b) <= epsilon) {
+			vtx = vertex(pos_b);
+		} else {
+			Distance mu;
+
+			// If close to midpoint then put at midpoint.
+			if (std::abs(val_a - val_b) <= epsilon) {
+				mu = Distance(0.5f);
+			} else
+			// Otherwise interpolate between endpoints.
+			{
+				mu = val_a / (val_a - val_b);
+			}
+
+			const VecDf vec_a = pos_a.template cast<Distance>();
+			const VecDf vec_b = pos_b.template cast<Distance>();
+			const VecDf vec_c = vec_a + (vec_b - vec_a) * mu;
+
+			vtx = vertex(vec_c);
+		}
+
+		return vtx;
+	}
+
+	/**
+	 * Construct a vertex at a position, calculating its normal only if the normals policy is
+	 * `eager`.
+	 *
+	 * @param pos_ position of vertex.
+	 * @return new vertex.
+	 */
+	template <typename Pos>
+	Vertex vertex(const Pos& pos_) const
+	{
+		if (m_normals == Normals::eager)
+			return Vertex(m_pisogrid, pos_);
+		return Vertex(pos_);
+	}
+
+	/**
+	 * Calculate corner mask of cube at pos, based on inside-outside status
+	 * of corners in isogrid.
+	 *
+	 * @param isogrid
+	 * @param pos
+	 * @return
+	 */
+	unsigned short mask (const VecDi& pos_) const
+	{
+		// Num corners == 2^D.  That is, 4 for 2D, 8 for 3D.
+		unsigned short mask = 0;
+		const ListIdx num_corners = (1 << t_dims);
+		for (ListIdx idx = 0; idx < num_corners; idx++)
+		{
+			const VecDi corner = pos_ + GeomImpl::corners[idx] * m_stride;
+			const Distance val = m_pisogrid->get(corner);
+			mask = (unsigned short)(mask | ((val > 0) << idx));
+		}
+		return mask;
+	}
+};
+
+
+/**
+ * Polygonisation of a single spatial partition of an isogrid using (naive) surface nets.
+ *
+ * A single vertex is placed in each cube (or square in 2D) that the zero-curve passes through, at
+ * the average of the zero-crossings along the cube's edges. Each grid edge crossed by the
+ * zero-curve then generates a face joining the vertices of the cubes sharing that edge, i.e. a
+ * quad (as two triangles) in 3D or a line segment in 2D.
+ *
+ * Compared to marching cubes this gives fewer, better shaped simplices.
+ *
+ * A cube at `pos` has corners `pos + {0,1}^D`. Each edge is polygonised by the partition
+ * containing its lower endpoint, so vertices of cubes in the neighbouring partitions along
+ * negative axes are also calculated (and stored) by this partition.
+ *
+ * Vertices are identified by cube rather than by edge, and are reported by `vtx_edges` as though
+ * lying along the first axis of the cube.
+ *
+ * The derived class must provide `ListIdx vtx_idx(const VecDi& pos, Dim axis) const` and
+ * `void vtx_idx(const VecDi& pos, Dim axis, ListIdx idx)` to get and set (null_idx to clear) the
+ * index of the vertex of the cube at `pos`, where `axis` is always zero.
+ *
+ * @tparam TDerived CRTP derived class.
+ */
+template <class TDerived>
+class Nets
+{
+private:
+	/// Traits of derived class.
+	using Traits = Impl::Traits<TDerived>;
+	/// Dimension of isogrid to polygonise.
+	static constexpr Dim t_dims = Traits::t_dims;
+	/// Number of cubes sharing an edge.
+	static constexpr ListIdx num_ring = 1 << (t_dims - 1);
+
+	using GeomImpl = Geom<TDerived>;
+
+	/// Strategy for choosing which cubes to polygonise.
+	using March = Impl::Poly::March;
+	/// Policy for calculating vertex normals.
+	using Normals = Impl::Poly::Normals;
+	/// Isogrid to (partially) polygonise.
+	using IsoGrid = typename Traits::IsoGrid;
+	/// Spatial partition type this poly will be responsible for.
+	using IsoChild = typename IsoGrid::Child;
+	/// Lookup grid of spatial partition this poly will be responsible for.
+	using IsoLookup = typename IsoChild::Lookup;
+	/// Integer vector.
+	using VecDi = Felt::VecDi<t_dims>;
+	/// Float vector.
+	using VecDf = Felt::VecDf<t_dims>;
+	/// Vertex type.
+	using Vertex = typename GeomImpl::Vertex;
+	/// Simplex type.
+	using Simplex = typename GeomImpl::Simplex;
+	/// Vertex array type for vertex storage.
+	using VtxArray = std::vector<Vertex>;
+	/// Simplex array type for simplex storage.
+	using SpxArray = std::vector<Simplex>;
+	/// Range of slots in a vertex or simplex array.
+	using Span = Impl::Poly::Span;
+	/// List of ranges of slots in a vertex or simplex array.
+	using Spans = Impl::Poly::Spans;
+
+	/// Isogrid to (partially) polygonise.
+	const IsoGrid*			m_pisogrid;
+	/// Lookup grid of isogrid spatial partition giving positions to march over.
+	const IsoLookup*		m_pisolookup;
+
+	/// List of vertices, one per cube crossed by the zero-curve.
+	VtxArray	m_a_vtx;
+	/// List of simplices (i.e. lines for 2D or triangles for 3D).
+	SpxArray	m_a_spx;
+	/// Cube of each vertex, encoded as an edge along the first axis (see `vtx_edges`).
+	PosIdxList	m_edge_idxs_vtx;
+	/// Policy for calculating vertex normals.
+	Normals		m_normals;
+	/// Ranges of vertex slots written by the last march.
+	Spans		m_vtx_spans;
+	/// Ranges of simplex slots written by the last march.
+	Spans		m_spx_spans;
+
+protected:
+	/**
+	 * Construct a polygonisation of (part of) an isogrid.
+	 *
+	 * @param isogrid_ grid to be (partially) polygonised.
+	 * @param normals_ policy for calculating vertex normals.
+	 */
+	Nets(const IsoGrid& isogrid_, const Normals normals_) :
+		m_pisogrid{&isogrid_}, m_pisolookup{nullptr}, m_normals{normals_}
+	{}
+
+	/**
+	 * Destroy the vertex and simplex arrays.
+	 */
+	void deactivate()
+	{
+		reset();
+		m_a_vtx.shrink_to_fit();
+		m_a_spx.shrink_to_fit();
+		m_edge_idxs_vtx.shrink_to_fit();
+	}
+
+	/**
+	 * Clear the vertex and simplex arrays without deallocating.
+	 *
+	 * Vertex indices cached by the derived class are cleared here.
+	 */
+	void reset()
+	{
+		for (const PosIdx edge_idx : m_edge_idxs_vtx)
+			pself->vtx_idx(edge_pos(edge_idx), 0, Felt::null_idx);
+		m_a_vtx.resize(0);
+		m_a_spx.resize(0);
+		m_edge_idxs_vtx.resize(0);
+		m_vtx_spans.resize(0);
+		m_spx_spans.resize(0);
+	}
+
+	/**
+	 * Update the polygonisation from the stored pointer to isogrid child lookup.
+	 *
+	 * Surface nets are always rebuilt from scratch, so the march strategy is ignored.
+	 *
+	 * @param march_ ignored.
+	 */
+	void march(const March march_ = March::all)
+	{
+		(void)march_;
+		pself->reset();
+
+		for (TupleIdx list_idx = 0; list_idx < m_pisolookup->num_lists; list_idx++)
+		{
+			for (PosIdx pos_idx_leaf : m_pisolookup->list(list_idx))
+			{
+				const VecDi& pos = m_pisolookup->index(pos_idx_leaf);
+				for (Dim axis = 0; axis < t_dims; axis++)
+					spx(pos, axis);
+			}
+		}
+
+		if (m_a_vtx.size())
+			m_vtx_spans.push_back(Span{0, m_a_vtx.size()});
+		if (m_a_spx.size())
+			m_spx_spans.push_back(Span{0, m_a_spx.size()});
+	}
+
+	/**
+	 * Mark an isogrid point as changed.
+	 *
+	 * Surface nets are always rebuilt from scratch, so does nothing.
+	 *
+	 * @return false, since the point is never recorded.
+	 */
+	bool dirty(const VecDi&)
+	{
+		return false;
+	}
+
+	/**
+	 * Force the next march to re-polygonise the whole partition.
+	 *
+	 * Surface nets are always rebuilt from scratch, so does nothing.
+	 */
+	void invalidate()
+	{}
+
+	/**
+	 * Set the level of detail.
+	 *
+	 * Surface nets only support full resolution, so only a stride of 1 is accepted.
+	 *
+	 * @param stride_ stride between sampled grid nodes, which must be 1.
+	 */
+	void stride(const NodeIdx stride_)
+	{
+		if (stride_ != 1)
+		{
+			std::stringstream sstr;
+			sstr << "Stride " << stride_ << " not supported by surface nets, which must be 1";
+			std::string str = sstr.str();
+			throw std::domain_error(str);
+		}
+	}
+
+	/**
+	 * Get the level of detail.
+	 *
+	 * @return 1, since surface nets always polygonise at full resolution.
+	 */
+	NodeIdx stride() const
+	{
+		return 1;
+	}
+
+	/**
+	 * Bind this Poly to the given Lookup grid giving positions to march over.
+	 *
+	 * @param isolookup_ lookup grid of isogrid spatial partition.
+	 */
+	void bind(const IsoLookup& isolookup_)
+	{
+		m_pisolookup = &isolookup_;
+	}
+
+	/**
+	 * Bind this Poly to a (copy of the) isogrid and a Lookup grid within it giving positions to
+	 * march over.
+	 *
+	 * @param isogrid_ grid to be (partially) polygonised.
+	 * @param isolookup_ lookup grid of spatial partition of isogrid_.
+	 */
+	void bind(const IsoGrid& isogrid_, const IsoLookup& isolookup_)
+	{
+		m_pisogrid = &isogrid_;
+		m_pisolookup = &isolookup_;
+	}
+
+	/**
+	 * Get the vertex array.
+	 *
+	 * @return
+	 */
+	const VtxArray& vtxs() const
+	{
+		return m_a_vtx;
+	}
+
+	/**
+	 * Get the array of simplices.
+	 *
+	 * @return
+	 */
+	const SpxArray& spxs() const
+	{
+		return m_a_spx;
+	}
+
+	/**
+	 * Get the ranges of vertex slots written by the last march, i.e. the whole array.
+	 *
+	 * @return list of slot ranges.
+	 */
+	const Spans& vtx_spans() const
+	{
+		return m_vtx_spans;
+	}
+
+	/**
+	 * Get the ranges of simplex slots written by the last march, i.e. the whole array.
+	 *
+	 * @return list of slot ranges.
+	 */
+	const Spans& spx_spans() const
+	{
+		return m_spx_spans;
+	}
+
+	/**
+	 * Get the normal of a vertex (3D only), according to the normals policy.
+	 *
+	 * @param vtx_idx_ index of vertex.
+	 * @return unit normal of vertex.
+	 */
+	VecDf norm(const ListIdx vtx_idx_)
+	{
+		Vertex& vtx = m_a_vtx[vtx_idx_];
+
+		switch (m_normals)
+		{
+		case Normals::none:
+			return Vertex(m_pisogrid, vtx.pos).norm;
+		case Normals::lazy:
+			if (std::isnan(vtx.norm(0)))
+				vtx.norm = Vertex(m_pisogrid, vtx.pos).norm;
+			return vtx.norm;
+		default:
+			return vtx.norm;
+		}
+	}
+
+	/**
+	 * Get the cube of each vertex, encoded as an edge along the first axis of the cube.
+	 *
+	 * @return encoded edge index for each vertex.
+	 */
+	const PosIdxList& vtx_edges() const
+	{
+		return m_edge_idxs_vtx;
+	}
+
+	/**
+	 * Get the lower endpoint of an edge.
+	 *
+	 * @param edge_idx_ encoded edge index.
+	 * @return position of lower endpoint of edge, i.e. position of cube.
+	 */
+	VecDi edge_pos(const PosIdx edge_idx_) const
+	{
+		return pself->index(edge_idx_ / t_dims);
+	}
+
+	/**
+	 * Get the axis along which an edge lies.
+	 *
+	 * @param edge_idx_ encoded edge index.
+	 * @return axis of edge, always zero.
+	 */
+	static Dim edge_axis(const PosIdx edge_idx_)
+	{
+		return Dim(edge_idx_ % t_dims);
+	}
+
+private:
+	/**
+	 * Generate the face (if any) for the edge starting at pos_ along axis_.
+	 *
+	 * The face joins the vertices of the cubes sharing the edge, ordered so that its normal points
+	 * from the inside to the outside of the surface.
+	 *
+	 * @param pos_ lower endpoint of edge.
+	 * @param axis_ axis along which the edge lies.
+	 */
+	void spx(const VecDi& pos_, const Dim axis_)
+	{
+		VecDi pos_b = pos_;
+		pos_b(axis_) += 1;
+
+		if (!m_pisogrid->inside(pos_b))
+			return;
+
+		const bool is_outside = m_pisogrid->get(pos_) > 0;
+		if (is_outside == (m_pisogrid->get(pos_b) > 0))
+			return;
+
+		// Vertices of cubes sharing the edge, in cyclic (Gray code) order over the other axes,
+		// giving a face normal along the positive axis (except for the first axis in 2D).
+		ListIdx vtx_idxs[num_ring];
+		for (ListIdx ring_idx = 0; ring_idx < num_ring; ring_idx++)
+		{
+			const ListIdx gray = ring_idx ^ (ring_idx >> 1);
+			VecDi pos_cube = pos_;
+			for (Dim axis_other = 1; axis_other < t_dims; axis_other++)
+				pos_cube((axis_ + axis_other) % t_dims) -= NodeIdx((gray >> (axis_other - 1)) & 1);
+
+			if (
+				!m_pisogrid->inside(pos_cube) ||
+				!m_pisogrid->inside(VecDi{pos_cube + VecDi::Constant(1)})
+			)
+				return;
+
+			vtx_idxs[ring_idx] = idx(pos_cube);
+		}
+
+		// Reverse to flip normal if required.
+		if (is_outside != (t_dims == 2 && axis_ == 0))
+			std::reverse(vtx_idxs, vtx_idxs + num_ring);
+
+		// Triangle fan (or single line in 2D) from first vertex.
+		for (ListIdx ring_idx = 1; ring_idx + t_dims - 1 <= num_ring; ring_idx++)
+		{
+			Simplex simplex;
+			simplex.idxs(0) = unsigned(vtx_idxs[0]);
+			for (Dim endpoint = 1; endpoint < t_dims; endpoint++)
+				simplex.idxs(endpoint) = unsigned(vtx_idxs[ring_idx + endpoint - 1]);
+			m_a_spx.push_back(std::move(simplex));
+		}
+	}
+
+	/**
+	 * Lookup, or calculate then store, and return the index into the vertex array of the vertex
+	 * of the cube at pos_cube_.
+	 *
+	 * @param pos_cube_ position of cube.
+	 * @return index of vertex.
+	 */
+	ListIdx idx(const VecDi& pos_cube_)
+	{
+		const ListIdx idx_lookup = pself->vtx_idx(pos_cube_, 0);
+		if (idx_lookup != Felt::null_idx)
+			return idx_lookup;
+
+		const ListIdx idx = m_a_vtx.size();
+		m_a_vtx.push_back(vtx(pos_cube_));
+		m_edge_idxs_vtx.push_back(pself->index(pos_cube_) * t_dims);
+		pself->vtx_idx(pos_cube_, 0, idx);
+		return idx;
+	}
+
+	/**
+	 * Calculate the vertex of a cube, at the average of the zero-crossings along its edges.
+	 *
+	 * @param pos_cube_ position of cube.
+	 * @return new vertex.
+	 */
+	Vertex vtx(const VecDi& pos_cube_) const
+	{
+		// Number of corners of a cube.
+		static constexpr PosIdx num_corners = 1 << t_dims;
+
+		VecDf pos_sum = VecDf::Zero();
+		Distance num_crossings = 0;
+
+		for (Dim axis = 0; axis < t_dims; axis++)
+		{
+			for (PosIdx corner_idx = 0; corner_idx < num_corners; corner_idx++)
+			{
+				// Only corners at the lower end of an edge along this axis.
+				if ((corner_idx >> axis) & 1)
+					continue;
+
+				VecDi pos_a = pos_cube_;
+				for (Dim axis_corner = 0; axis_corner < t_dims; axis_corner++)
+					pos_a(axis_corner) += NodeIdx((corner_idx >> axis_corner) & 1);
+				VecDi pos_b = pos_a;
+				pos_b(axis) += 1;
+
+				const Distance val_a = m_pisogrid->get(pos_a);
+				const Distance val_b = m_pisogrid->get(pos_b);
+				if ((val_a > 0) == (val_b > 0))
+					continue;
+
+				const Distance mu = val_a / (val_a - val_b);
+				const VecDf vec_a = pos_a.template cast<Distance>();
+				const VecDf vec_b = pos_b.template cast<Distance>();
+				pos_sum += vec_a + (vec_b - vec_a) * mu;
+				num_crossings++;
+			}
+		}
+
+		const VecDf pos = pos_sum / num_crossings;
+
+		if (m_normals == Normals::eager)
+			return Vertex(m_pisogrid, pos);
+		return Vertex(pos);
+	}
+};
+
 } // Poly.
 } // Mixin.
 } // Impl.
@@ -2,6 +2,7 @@
 #define INCLUDE_FELT_IMPL_POLY_HPP_
 
 #include <Felt/Impl/Common.hpp>
+#include <Felt/Impl/Hash.hpp>
 #include <Felt/Impl/Mixin/GridMixin.hpp>
 #include <Felt/Impl/Mixin/PolyMixin.hpp>
 #include <Felt/Impl/Mixin/TrackedMixin.hpp>
@@ -14,68 +15,69 @@ namespace Impl
 namespace Poly
 {
 
+/**
+ * Polygonisation of a single spatial partition, caching vertices in a dense lookup grid.
+ *
+ * The lookup grid stores a vertex index for each positively directed edge at every grid node,
+ * giving constant time access at the cost of memory proportional to the partition volume.
+ *
+ * @tparam TIsoGrid isogrid type to polygonise.
+ */
 template <class TIsoGrid>
 class Single :
 	FELT_MIXINS(
 		(Single<TIsoGrid>),
-		(Grid::Access::ByRef)(Grid::Data)(Poly::Geom)(Tracked::Activate)(Tracked::SingleList::Reset)
-		(Tracked::Resize)(Tracked::LookupInterface),
+		(Grid::Access::ByRef)(Grid::Data)(Poly::Geom)(Poly::Polygonise)(Tracked::Activate)
+		(Tracked::SingleList::Reset)(Tracked::Resize)(Tracked::LookupInterface),
 		(Grid::Activate)(Grid::Index)(Grid::Resize)(Grid::Size)
 	)
 private:
 	using This = Single<TIsoGrid>;
 	using Traits = Impl::Traits<This>;
 
-	/// Small epsilon value within which we consider vertex position as "exact".
-	static constexpr Distance epsilon = std::numeric_limits<Distance>::epsilon();
 	/// Dimension of isogrid to polygonise.
 	static constexpr Dim t_dims = Traits::t_dims;
 
 	using ActivateImpl = Impl::Mixin::Tracked::Activate<This>;
 	using GeomImpl = Impl::Mixin::Poly::Geom<This>;
 	using LookupInterfaceImpl = Impl::Mixin::Tracked::LookupInterface<This>;
+	using PolygoniseImpl = Impl::Mixin::Poly::Polygonise<This>;
 	using ResetImpl = Impl::Mixin::Tracked::SingleList::Reset<This>;
 	using ResizeImpl = Impl::Mixin::Tracked::Resize<This>;
 
 	using Lookup = typename Traits::Lookup;
 	/// Isogrid to (partially) polygonise.
 	using IsoGrid = typename Traits::IsoGrid;
-	/// Spatial partition type this poly will be responsible for.
-	using IsoChild = typename IsoGrid::Child;
-	/// Spatial partition type this poly will be responsible for.
-	using IsoLookup = typename IsoChild::Lookup;
 	/// Vertex index tuple type (for spatial lookup grid).
 	using IdxTuple = typename Traits::Leaf;
 	/// Integer vector.
 	using VecDi = Felt::VecDi<t_dims>;
-	/// Float vector.
-	using VecDf = Felt::VecDf<t_dims>;
-	/// Cube edge type.
-	using Edge = typename GeomImpl::Edge;
+	/// Policy for calculating vertex normals.
+	using Normals = Impl::Poly::Normals;
 public:
 	/// Vertex type.
 	using Vertex = typename GeomImpl::Vertex;
 	/// Simplex type.
 	using Simplex = typename GeomImpl::Simplex;
 private:
-	/// Vertex array type for vertex storage.
-	using VtxArray = std::vector<Vertex>;
-	/// Simplex array type for simplex storage.
-	using SpxArray = std::vector<Simplex>;
-
-
-	/// Isogrid to (partially) polygonise.
-	const IsoGrid*			m_pisogrid;
-	const IsoLookup*		m_pisolookup;
-
-	/// List of interpolated vertices.
-	VtxArray	m_a_vtx;
-	/// List of simplexes (i.e. lines for 2D or triangles for 3D).
-	SpxArray	m_a_spx;
+	/// First simplex generated by each cube (indexed as the lookup grid), or null_idx if none.
+	std::vector<ListIdx>	m_spx_idxs_head;
 
 public:
 	using ActivateImpl::is_active;
-	using ActivateImpl::activate;
+	using PolygoniseImpl::bind;
+	using PolygoniseImpl::dirty;
+	using PolygoniseImpl::edge_axis;
+	using PolygoniseImpl::edge_pos;
+	using PolygoniseImpl::invalidate;
+	using PolygoniseImpl::march;
+	using PolygoniseImpl::norm;
+	using PolygoniseImpl::spx_spans;
+	using PolygoniseImpl::spxs;
+	using PolygoniseImpl::stride;
+	using PolygoniseImpl::vtx_edges;
+	using PolygoniseImpl::vtx_spans;
+	using PolygoniseImpl::vtxs;
 	using ResizeImpl::offset;
 	using ResizeImpl::size;
 
@@ -83,22 +85,31 @@ public:
 	 * Construct a non-partitioned polygonisation of an isogrid.
 	 *
 	 * @param isogrid_ grid to be (partially) polygonised.
+	 * @param normals_ policy for calculating vertex normals.
 	 */
-	Single(const IsoGrid& isogrid_) :
-		ActivateImpl{IdxTuple::Constant(Felt::null_idx)}, LookupInterfaceImpl{Lookup{}},
-		m_pisogrid{&isogrid_}, m_pisolookup{nullptr}
+	Single(const IsoGrid& isogrid_, const Normals normals_ = Normals::eager) :
+		PolygoniseImpl{isogrid_, normals_}, ActivateImpl{IdxTuple::Constant(Felt::null_idx)},
+		LookupInterfaceImpl{Lookup{}}
 	{}
 
+	/**
+	 * Initialise the internal data array and lookup grid.
+	 */
+	void activate()
+	{
+		ActivateImpl::activate();
+		m_spx_idxs_head.assign(this->data().size(), Felt::null_idx);
+	}
+
 	/**
 	 * Destroy the internal data array and lookup grid.
 	 */
 	void deactivate()
 	{
+		PolygoniseImpl::deactivate();
 		ActivateImpl::deactivate();
-		m_a_vtx.resize(0);
-		m_a_vtx.shrink_to_fit();
-		m_a_spx.resize(0);
-		m_a_spx.shrink_to_fit();
+		m_spx_idxs_head.resize(0);
+		m_spx_idxs_head.shrink_to_fit();
 	}
 
 	/**
@@ -108,9 +119,8 @@ public:
 	 */
 	void reset()
 	{
+		PolygoniseImpl::reset();
 		ResetImpl::reset();
-		m_a_vtx.resize(0);
-		m_a_spx.resize(0);
 	}
 
 	/**
@@ -133,240 +143,392 @@ public:
 	}
 
 	/**
-	 * Update the polygonisation from the stored pointer to isogrid child lookup.
+	 * Get index of the vertex (if any) cached for the zero-crossing along an edge.
+	 *
+	 * @param pos_ lower endpoint of edge.
+	 * @param axis_ axis along which the edge lies.
+	 * @return index into vertex array, or null_idx if not calculated or outside this partition.
+	 */
+	ListIdx vtx_idx(const VecDi& pos_, const Dim axis_) const
+	{
+		if (!this->is_active() || !this->inside(pos_))
+			return Felt::null_idx;
+		return this->get(pos_)(axis_);
+	}
+
+private:
+	/**
+	 * Cache index of the vertex for the zero-crossing along an edge.
+	 *
+	 * @param pos_ lower endpoint of edge.
+	 * @param axis_ axis along which the edge lies.
+	 * @param idx_ index into vertex array, or null_idx to clear.
+	 */
+	void vtx_idx(const VecDi& pos_, const Dim axis_, const ListIdx idx_)
+	{
+		this->get(pos_)(axis_) = idx_;
+		if (idx_ != Felt::null_idx)
+			this->lookup().track(this->lookup().index(pos_));
+	}
+
+	/**
+	 * Get index of the first simplex generated by a cube.
+	 *
+	 * @param pos_idx_ position index of cube.
+	 * @return index into simplex array, or null_idx if none.
+	 */
+	ListIdx spx_idx(const PosIdx pos_idx_) const
+	{
+		return m_spx_idxs_head[pos_idx_];
+	}
+
+	/**
+	 * Set index of the first simplex generated by a cube.
+	 *
+	 * @param pos_idx_ position index of cube.
+	 * @param idx_ index into simplex array, or null_idx if none.
+	 */
+	void spx_idx(const PosIdx pos_idx_, const ListIdx idx_)
+	{
+		m_spx_idxs_head[pos_idx_] = idx_;
+	}
+};
+
+
+/**
+ * Polygonisation of a single spatial partition, caching vertices in a hash map.
+ *
+ * Only edges that actually have a vertex (and cubes that actually have simplices) take up
+ * memory, so memory use and the cost of `reset` are proportional to the size of the
+ * polygonisation, rather than to the partition volume, at the cost of slower vertex lookup.
+ *
+ * @tparam TIsoGrid isogrid type to polygonise.
+ */
+template <class TIsoGrid>
+class Hashed :
+	FELT_MIXINS(
+		(Hashed<TIsoGrid>),
+		(Grid::Index)(Grid::Resize)(Poly::Geom)(Poly::Polygonise),
+		(Grid::Size)
+	)
+private:
+	using This = Hashed<TIsoGrid>;
+	using Traits = Impl::Traits<This>;
+
+	/// Dimension of isogrid to polygonise.
+	static constexpr Dim t_dims = Traits::t_dims;
+
+	using GeomImpl = Impl::Mixin::Poly::Geom<This>;
+	using IndexImpl = Impl::Mixin::Grid::Index<This>;
+	using PolygoniseImpl = Impl::Mixin::Poly::Polygonise<This>;
+	using ResizeImpl = Impl::Mixin::Grid::Resize<This>;
+
+	/// Isogrid to (partially) polygonise.
+	using IsoGrid = typename Traits::IsoGrid;
+	/// Integer vector.
+	using VecDi = Felt::VecDi<t_dims>;
+	/// Policy for calculating vertex normals.
+	using Normals = Impl::Poly::Normals;
+public:
+	/// Vertex type.
+	using Vertex = typename GeomImpl::Vertex;
+	/// Simplex type.
+	using Simplex = typename GeomImpl::Simplex;
+private:
+	/// Map from encoded edge (see `vtx_edges`) to vertex index.
+	Impl::Hash::Map	m_map_vtx_idxs;
+	/// Map from cube position index to index of first simplex generated by that cube.
+	Impl::Hash::Map	m_map_spx_idxs;
+	/// Whether this partition is active.
+	bool			m_is_active;
+
+public:
+	using PolygoniseImpl::bind;
+	using PolygoniseImpl::dirty;
+	using PolygoniseImpl::edge_axis;
+	using PolygoniseImpl::edge_pos;
+	using PolygoniseImpl::invalidate;
+	using PolygoniseImpl::march;
+	using PolygoniseImpl::norm;
+	using PolygoniseImpl::spx_spans;
+	using PolygoniseImpl::spxs;
+	using PolygoniseImpl::stride;
+	using PolygoniseImpl::vtx_edges;
+	using PolygoniseImpl::vtx_spans;
+	using PolygoniseImpl::vtxs;
+	using ResizeImpl::offset;
+	using ResizeImpl::size;
+
+	/**
+	 * Construct a non-partitioned polygonisation of an isogrid.
+	 *
+	 * @param isogrid_ grid to be (partially) polygonised.
+	 * @param normals_ policy for calculating vertex normals.
+	 */
+	Hashed(const IsoGrid& isogrid_, const Normals normals_ = Normals::eager) :
+		PolygoniseImpl{isogrid_, normals_}, m_is_active{false}
+	{}
+
+	/**
+	 * Check if this partition is active.
+	 *
+	 * @return true if active, false otherwise.
+	 */
+	bool is_active() const
+	{
+		return m_is_active;
+	}
+
+	/**
+	 * Mark as active, ready to be polygonised.
+	 */
+	void activate()
+	{
+		m_is_active = true;
+	}
+
+	/**
+	 * Destroy the vertex cache and vertex and simplex arrays.
+	 */
+	void deactivate()
+	{
+		PolygoniseImpl::deactivate();
+		m_map_vtx_idxs.deallocate();
+		m_map_spx_idxs.deallocate();
+		m_is_active = false;
+	}
+
+	/**
+	 * Reset without deallocating.
 	 */
-	void march()
+	void reset()
 	{
-		for (TupleIdx list_idx = 0; list_idx < m_pisolookup->num_lists; list_idx++)
-		{
-			for (PosIdx pos_idx_leaf : m_pisolookup->list(list_idx))
-			{
-				spx(m_pisolookup->index(pos_idx_leaf));
-			}
-		}
+		PolygoniseImpl::reset();
+		m_map_vtx_idxs.clear();
+		m_map_spx_idxs.clear();
 	}
 
 	/**
-	 * Bind this Poly to the given Lookup grid giving positions to march over.
+	 * Resize to fit size of isogrid child spatial partition.
 	 *
-	 * I.e. a child spatial partition of the isogrid.
+	 * Will resize to one more than isochild size, since neighbouring Polys must overlap.
+	 *
+	 * @param size_ size of isogrid child partition.
+	 * @param offset_ offset of isogrid child partition.
+	 */
+	void resize(const VecDi& size_, const VecDi& offset_)
+	{
+		static const VecDi one = VecDi::Constant(1);
+		static const VecDi two = VecDi::Constant(2);
+
+		ResizeImpl::resize(size_ + two, offset_ - one);
+	}
+
+	/**
+	 * Get index of the vertex (if any) cached for the zero-crossing along an edge.
 	 *
-	 * @param pisolookup
+	 * @param pos_ lower endpoint of edge.
+	 * @param axis_ axis along which the edge lies.
+	 * @return index into vertex array, or null_idx if not calculated or outside this partition.
 	 */
-	void bind(const IsoLookup& isolookup)
+	ListIdx vtx_idx(const VecDi& pos_, const Dim axis_) const
 	{
-		m_pisolookup = &isolookup;
+		if (!m_is_active || !this->inside(pos_))
+			return Felt::null_idx;
+		return m_map_vtx_idxs.get(this->index(pos_) * t_dims + axis_);
 	}
 
+private:
 	/**
-	 * Get a pointer to the isogrid child's lookup grid that gives points to polygonise.
+	 * Cache index of the vertex for the zero-crossing along an edge.
 	 *
-	 * @return lookup grid to iterate over.
+	 * @param pos_ lower endpoint of edge.
+	 * @param axis_ axis along which the edge lies.
+	 * @param idx_ index into vertex array, or null_idx to clear.
 	 */
-	IsoLookup const* bind() const
+	void vtx_idx(const VecDi& pos_, const Dim axis_, const ListIdx idx_)
 	{
-		return m_pisolookup;
+		m_map_vtx_idxs.set(this->index(pos_) * t_dims + axis_, idx_);
 	}
 
 	/**
-	 * Get the vertex array.
+	 * Get index of the first simplex generated by a cube.
 	 *
-	 * @return
+	 * @param pos_idx_ position index of cube.
+	 * @return index into simplex array, or null_idx if none.
 	 */
-	const VtxArray& vtxs() const
+	ListIdx spx_idx(const PosIdx pos_idx_) const
 	{
-		return m_a_vtx;
+		return m_map_spx_idxs.get(pos_idx_);
 	}
 
 	/**
-	 * Get the array of simplices.
+	 * Set index of the first simplex generated by a cube.
 	 *
-	 * @return
+	 * @param pos_idx_ position index of cube.
+	 * @param idx_ index into simplex array, or null_idx if none.
 	 */
-	const SpxArray& spxs() const
+	void spx_idx(const PosIdx pos_idx_, const ListIdx idx_)
 	{
-		return m_a_spx;
+		m_map_spx_idxs.set(pos_idx_, idx_);
 	}
+};
+
+
+/**
+ * Polygonisation of a single spatial partition of an isogrid using surface nets.
+ *
+ * An alternative to `Single` (marching cubes) that generates roughly one vertex per cube crossed
+ * by the zero-curve, joined into quads (as pairs of triangles) in 3D or lines in 2D, giving
+ * fewer, better shaped simplices.
+ *
+ * Surface nets are always rebuilt from scratch when marched, and only at full resolution, so
+ * `stride` accepts only 1 and level of detail via `Polys::stride` or `Polys::lod` is unsupported.
+ *
+ * @tparam TIsoGrid isogrid type to polygonise.
+ */
+template <class TIsoGrid>
+class Nets :
+	FELT_MIXINS(
+		(Nets<TIsoGrid>),
+		(Grid::Index)(Grid::Resize)(Poly::Geom)(Poly::Nets),
+		(Grid::Size)
+	)
+private:
+	using This = Nets<TIsoGrid>;
+	using Traits = Impl::Traits<This>;
 
+	/// Dimension of isogrid to polygonise.
+	static constexpr Dim t_dims = Traits::t_dims;
+
+	using GeomImpl = Impl::Mixin::Poly::Geom<This>;
+	using IndexImpl = Impl::Mixin::Grid::Index<This>;
+	using NetsImpl = Impl::Mixin::Poly::Nets<This>;
+	using ResizeImpl = Impl::Mixin::Grid::Resize<This>;
+
+	/// Isogrid to (partially) polygonise.
+	using IsoGrid = typename Traits::IsoGrid;
+	/// Integer vector.
+	using VecDi = Felt::VecDi<t_dims>;
+	/// Policy for calculating vertex normals.
+	using Normals = Impl::Poly::Normals;
+public:
+	/// Vertex type.
+	using Vertex = typename GeomImpl::Vertex;
+	/// Simplex type.
+	using Simplex = typename GeomImpl::Simplex;
 private:
+	/// Index of the vertex of each cube, or null_idx if none.
+	std::vector<ListIdx>	m_vtx_idxs;
+
+public:
+	using NetsImpl::bind;
+	using NetsImpl::dirty;
+	using NetsImpl::edge_axis;
+	using NetsImpl::edge_pos;
+	using NetsImpl::invalidate;
+	using NetsImpl::march;
+	using NetsImpl::norm;
+	using NetsImpl::spx_spans;
+	using NetsImpl::spxs;
+	using NetsImpl::stride;
+	using NetsImpl::vtx_edges;
+	using NetsImpl::vtx_spans;
+	using NetsImpl::vtxs;
+	using ResizeImpl::offset;
+	using ResizeImpl::size;
+
+	/**
+	 * Construct a non-partitioned polygonisation of an isogrid.
+	 *
+	 * @param isogrid_ grid to be (partially) polygonised.
+	 * @param normals_ policy for calculating vertex normals.
+	 */
+	Nets(const IsoGrid& isogrid_, const Normals normals_ = Normals::eager) :
+		NetsImpl{isogrid_, normals_}
+	{}
+
+	/**
+	 * Check if this partition is active.
+	 *
+	 * @return true if active, false otherwise.
+	 */
+	bool is_active() const
+	{
+		return m_vtx_idxs.size() > 0;
+	}
+
 	/**
-	 * Generate simplex(es) for isogrid grid at position pos.
+	 * Allocate the vertex cache, ready to be polygonised.
+	 */
+	void activate()
+	{
+		m_vtx_idxs.assign(PosIdx(this->size().prod()), Felt::null_idx);
+	}
+
+	/**
+	 * Destroy the vertex cache and vertex and simplex arrays.
+	 */
+	void deactivate()
+	{
+		NetsImpl::deactivate();
+		m_vtx_idxs = std::vector<ListIdx>{};
+	}
+
+	/**
+	 * Reset without deallocating.
+	 */
+	void reset()
+	{
+		NetsImpl::reset();
+	}
+
+	/**
+	 * Resize to fit size of isogrid child spatial partition.
 	 *
-	 * @param pos
-	 * @param m_isogrid
+	 * Will resize to one more than isochild size, since neighbouring Polys must overlap.
+	 *
+	 * @param size_ size of isogrid child partition.
+	 * @param offset_ offset of isogrid child partition.
 	 */
-	void spx(const VecDi& pos)
+	void resize(const VecDi& size_, const VecDi& offset_)
 	{
-		// TODO: this is here for consistency only, since the marching
-		// cubes implementation marches in the negative z-axis, but
-		// positive x and y axes. Hence an offset is required so that the
-		// negative z-axis marching is compensated by shifting the
-		// calculation in the +z direction by one grid node.
-		// (NOTE: has no effect for 2D).
-		const VecDi pos_calc = pos - GeomImpl::SpxGridPosOffset;
-
-		// Get corner inside-outside bitmask at this position.
-		const unsigned short mask = this->mask(pos_calc);
-		// Array of indices of zero-crossing vertices along each axis from
-		// this corner.
-		unsigned vtx_idxs[GeomImpl::num_edges];
-		// Look up the edges that are crossed from the corner mask.
-		unsigned short vtx_mask = GeomImpl::vtx_mask[mask];
-		const short* vtx_order = GeomImpl::vtx_order[mask];
-
-		// Cube corners are all inside or all outside.
-		if (vtx_order[0] == -1)
-			return;
-
-		// Loop over each crossed edge in the cube, looking up
-		// (or calculating, if unavailable) the vertices at the
-		// zero-crossing.
-		for (ListIdx edge_idx = 0; edge_idx < GeomImpl::num_edges; edge_idx++ )
-		{
-			// Check if current edge is crossed by the zero curve.
-			if ((vtx_mask >> edge_idx) & 1)
-			{
-				const Edge& edge = GeomImpl::edges[edge_idx];
-				// Edges are defined as an axis and an offset.
-				// Look up index of vertex along current edge.
-				vtx_idxs[edge_idx] = unsigned(idx(pos_calc + edge.offset, edge.axis));
-			}
-		}
-
-		// Check for degenerates. Compare every calculated vertex to every
-		// other to ensure they are not located on top of one-another.
-		// E.g. corners that lie at precisely zero will have D vertices that
-		// all lie on that corner.
-		// TODO: can't just throw away all triangles like this - others may
-		// be valid - must do a per-simplex degenerate check. Maybe not
-		// worth it, though.
-//			for (UINT edge_idx1 = 0; edge_idx1 < PolyBase<D>::num_edges - 1;
-//				edge_idx1++
-//			) {
-//				for (UINT edge_idx2 = edge_idx1+1;
-//					edge_idx2 < PolyBase<D>::num_edges; edge_idx2++)
-//				{
-//					// Check both edges are bisected by the zero-curve.
-//					if (!(((vtx_mask >> edge_idx1) & 1)
-//						&& ((vtx_mask >> edge_idx2) & 1)))
-//						continue;
-//
-//					// Get the position vector component of the vertex
-//					// information for both edges.
-//					const VecDf& pos1 = this->vtx(vtx_idxs[edge_idx1]).pos;
-//					const VecDf& pos2 = this->vtx(vtx_idxs[edge_idx2]).pos;
-//					const FLOAT dist = (pos1 - pos2).squaredNorm();
-//					// If they are essentially the same vertex,
-//					// then there is no simplex for this cube.
-//					if (dist <= This::epsilon())
-//						return;
-//				}
-//			}
-
-		// Join the vertices along each edge that the surface crosses to
-		// make a simplex (or simplices).
-		// The vtx_order lookup translates corner in-out mask to CCW
-		// vertex ordering. We take D elements at a time from the lookup,
-		// with each successive subset of D elements forming the next
-		// simplex.
-		for (ListIdx order_idx = 0; vtx_order[order_idx] != -1; order_idx += t_dims )
-		{
-			Simplex simplex;
-			// A simplex for number of dimensions D has D vertices,
-			// i.e. D endpoints.
-			for (Dim endpoint = 0; endpoint < t_dims; endpoint++)
-			{
-				// Each vertex of the simplex is stored as an index
-				// reference into the 'global' vertex array.
-				simplex.idxs(endpoint) = vtx_idxs[ vtx_order[order_idx+ListIdx(endpoint)] ];
-			}
-			// Append the simplex to the list of simplices that make up the
-			// polygonisation of this grid location.
-			m_a_spx.push_back(std::move(simplex));
-		}
-	} // End spx.
+		static const VecDi one = VecDi::Constant(1);
+		static const VecDi two = VecDi::Constant(2);
 
+		ResizeImpl::resize(size_ + two, offset_ - one);
+	}
 
 	/**
-	 * Lookup, or calculate then store, and return the index into the vertex
-	 * array of a vertex at the zero-crossing of isogrid at pos_a along axis.
+	 * Get index of the vertex (if any) of a cube.
 	 *
-	 * @return
+	 * @param pos_ position of cube.
+	 * @param axis_ ignored, since there is one vertex per cube.
+	 * @return index into vertex array, or null_idx if not calculated or outside this partition.
 	 */
-	ListIdx idx(const VecDi& pos_a, const Dim axis)
+	ListIdx vtx_idx(const VecDi& pos_, const Dim axis_) const
 	{
-		// Check lookup to see if vertex has already been calculated.
-		const ListIdx idx_lookup = this->get(pos_a)(axis);
-		if (idx_lookup != Felt::null_idx) {
-			return idx_lookup;
-		}
-
-		// Position of opposite endpoint.
-		VecDi pos_b(pos_a);
-		pos_b(axis) += 1;
-
-		// Value of isogrid at each endpoint of this edge.
-		const Distance val_a = m_pisogrid->get(pos_a);
-		const Distance val_b = m_pisogrid->get(pos_b);
-
-		// The newly created vertex.
-		Vertex vtx;
-
-		// Check if lies very close to an endpoint or midpoint, if so then no need (and possibly
-		// dangerous) to interpolate.
-		if (std::abs(val_a) <= epsilon) {
-			vtx = Vertex(m_pisogrid, pos_a);
-		} else if (std::abs(val_b) <= epsilon) {
-			vtx = Vertex(m_pisogrid, pos_b);
-		} else {
-			Distance mu;
-
-			// If close to midpoint then put at midpoint.
-			if (std::abs(val_a - val_b) <= epsilon) {
-				mu = Distance(0.5f);
-			} else
-			// Otherwise interpolate between endpoints.
-			{
-				mu = val_a / (val_a - val_b);
-			}
-
-			const VecDf vec_a = pos_a.template cast<Distance>();
-			const VecDf vec_b = pos_b.template cast<Distance>();
-			const VecDf vec_c = vec_a + (vec_b - vec_a) * mu;
-
-			vtx = Vertex(m_pisogrid, vec_c);
-		}
-
-		// Append newly created vertex to the cache and return a reference  to it.
-		const ListIdx idx = m_a_vtx.size();
-		m_a_vtx.push_back(std::move(vtx));
-		this->get(pos_a)(axis) = idx;
-		this->lookup().track(this->lookup().index(pos_a));
-		return idx;
+		(void)axis_;
+		if (!is_active() || !this->inside(pos_))
+			return Felt::null_idx;
+		return m_vtx_idxs[this->index(pos_)];
 	}
 
+private:
 	/**
-	 * Calculate corner mask of cube at pos, based on inside-outside status
-	 * of corners in isogrid.
+	 * Cache index of the vertex of a cube.
 	 *
-	 * @param isogrid
-	 * @param pos
-	 * @return
+	 * @param pos_ position of cube.
+	 * @param axis_ ignored, since there is one vertex per cube.
+	 * @param idx_ index into vertex array, or null_idx to clear.
 	 */
-	unsigned short mask (const VecDi& pos_) const
+	void vtx_idx(const VecDi& pos_, const Dim axis_, const ListIdx idx_)
 	{
-		// Num corners == 2^D.  That is, 4 for 2D, 8 for 3D.
-		unsigned short mask = 0;
-		const ListIdx num_corners = (1 << t_dims);
-		for (ListIdx idx = 0; idx < num_corners; idx++)
-		{
-			const VecDi corner = pos_ + GeomImpl::corners[idx];
-			const Distance val = m_pisogrid->get(corner);
-			mask = (unsigned short)(mask | ((val > 0) << idx));
-		}
-		return mask;
+		(void)axis_;
+		m_vtx_idxs[this->index(pos_)] = idx_;
 	}
 };
+
 } // Poly.
 } // Impl.
 } // Felt.
@@ -394,6 +556,33 @@ struct Traits< Poly::Single<TIsoGrid> >
 	using IsoGrid = TIsoGrid;
 };
 
+/**
+ * Traits for Poly::Hashed.
+ *
+ * @tparam IsoGrid isogrid type to polygonise.
+ */
+template <class TIsoGrid>
+struct Traits< Poly::Hashed<TIsoGrid> >
+{
+	/// Dimension of grid.
+	static constexpr Dim t_dims = Traits<TIsoGrid>::t_dims;
+	/// IsoGrid type that will be polygonised.
+	using IsoGrid = TIsoGrid;
+};
+/**
+ * Traits for Poly::Nets.
+ *
+ * @tparam IsoGrid isogrid type to polygonise.
+ */
+template <class TIsoGrid>
+struct Traits< Poly::Nets<TIsoGrid> >
+{
+	/// Dimension of grid.
+	static constexpr Dim t_dims = Traits<TIsoGrid>::t_dims;
+	/// IsoGrid type that will be polygonised.
+	using IsoGrid = TIsoGrid;
+};
+
 } // Impl.
 } // Felt.
 
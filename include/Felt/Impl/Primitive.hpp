@@ -0,0 +1,178 @@
+#ifndef INCLUDE_FELT_IMPL_PRIMITIVE_HPP_
+#define INCLUDE_FELT_IMPL_PRIMITIVE_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <Felt/Impl/Common.hpp>
+#include <Felt/Impl/Util.hpp>
+
+namespace Felt
+{
+namespace Impl
+{
+namespace Primitive
+{
+
+/**
+ * Kind of primitive shape.
+ */
+enum class Kind : std::uint8_t
+{
+	/// City-block diamond about an integer point, as placed by `Surface::seed`.
+	point,
+	/// Euclidean sphere.
+	sphere,
+	/// Axis-aligned box.
+	box
+};
+
+/**
+ * Simple shape with an analytic signed distance function, for stamping into a surface.
+ *
+ * @tparam D number of dimensions.
+ */
+template <Dim D>
+class Shape
+{
+private:
+	/// D-dimensional integer vector.
+	using VecDi = Felt::VecDi<D>;
+	/// D-dimensional float vector.
+	using VecDf = Felt::VecDf<D>;
+
+	/// Kind of shape.
+	Kind	m_kind;
+	/// Centre of shape.
+	VecDf	m_centre;
+	/// Distance from centre to surface of shape along each axis (zero for a point).
+	VecDf	m_extents;
+
+public:
+	/**
+	 * Construct a point, i.e. a city-block distance field about an integer position.
+	 *
+	 * @param pos_ position of point.
+	 * @return point shape.
+	 */
+	static Shape point(const VecDi& pos_)
+	{
+		return Shape{Kind::point, pos_.template cast<Distance>(), VecDf::Zero()};
+	}
+
+	/**
+	 * Construct a sphere.
+	 *
+	 * @param centre_ centre of sphere.
+	 * @param radius_ radius of sphere.
+	 * @return sphere shape.
+	 */
+	static Shape sphere(const VecDf& centre_, const Distance radius_)
+	{
+		if (!(radius_ >= 0))
+		{
+			std::stringstream sstr;
+			sstr << "Sphere radius " << radius_ << " must not be negative";
+			std::string str = sstr.str();
+			throw std::domain_error(str);
+		}
+		return Shape{Kind::sphere, centre_, VecDf::Constant(radius_)};
+	}
+
+	/**
+	 * Construct an axis-aligned box.
+	 *
+	 * @param lower_ lower corner of box.
+	 * @param upper_ upper corner of box.
+	 * @return box shape.
+	 */
+	static Shape box(const VecDf& lower_, const VecDf& upper_)
+	{
+		if ((upper_.array() < lower_.array()).any())
+		{
+			std::stringstream sstr;
+			sstr << "Box upper corner " << Felt::format(upper_) <<
+				" must not be less than lower corner " << Felt::format(lower_);
+			std::string str = sstr.str();
+			throw std::domain_error(str);
+		}
+		return Shape{Kind::box, (lower_ + upper_) / 2, (upper_ - lower_) / 2};
+	}
+
+	/**
+	 * Get kind of shape.
+	 *
+	 * @return kind.
+	 */
+	Kind kind() const
+	{
+		return m_kind;
+	}
+
+	/**
+	 * Get signed distance from a position to the surface of the shape, negative inside.
+	 *
+	 * @param pos_ position to query.
+	 * @return signed distance.
+	 */
+	Distance distance(const VecDi& pos_) const
+	{
+		const VecDf& vec_dist = pos_.template cast<Distance>() - m_centre;
+
+		switch (m_kind)
+		{
+		case Kind::point:
+			return vec_dist.template lpNorm<1>();
+		case Kind::sphere:
+			return vec_dist.norm() - m_extents(0);
+		case Kind::box:
+		default:
+			const VecDf& vec_out = vec_dist.cwiseAbs() - m_extents;
+			return vec_out.cwiseMax(0).norm() + std::min(vec_out.maxCoeff(), Distance(0));
+		}
+	}
+
+	/**
+	 * Get lower corner of the integer bounding box of positions within a distance of the shape.
+	 *
+	 * @param reach_ distance from surface of shape.
+	 * @return lower corner (inclusive).
+	 */
+	VecDi lower(const Distance reach_) const
+	{
+		return (m_centre - m_extents - VecDf::Constant(reach_)).array().floor().matrix()
+			.template cast<NodeIdx>();
+	}
+
+	/**
+	 * Get upper corner of the integer bounding box of positions within a distance of the shape.
+	 *
+	 * @param reach_ distance from surface of shape.
+	 * @return upper corner (inclusive).
+	 */
+	VecDi upper(const Distance reach_) const
+	{
+		return (m_centre + m_extents + VecDf::Constant(reach_)).array().ceil().matrix()
+			.template cast<NodeIdx>();
+	}
+
+private:
+	/**
+	 * Construct a shape.
+	 *
+	 * @param kind_ kind of shape.
+	 * @param centre_ centre of shape.
+	 * @param extents_ distance from centre to surface along each axis.
+	 */
+	Shape(const Kind kind_, const VecDf& centre_, const VecDf& extents_) :
+		m_kind{kind_}, m_centre{centre_}, m_extents{extents_}
+	{}
+};
+
+} // Primitive.
+} // Impl.
+} // Felt.
+
+#endif /* INCLUDE_FELT_IMPL_PRIMITIVE_HPP_ */
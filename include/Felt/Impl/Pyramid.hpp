@@ -0,0 +1,172 @@
+#ifndef INCLUDE_FELT_IMPL_PYRAMID_HPP_
+#define INCLUDE_FELT_IMPL_PYRAMID_HPP_
+
+#include <vector>
+#include <Felt/Impl/Common.hpp>
+#include <Felt/Impl/Grid.hpp>
+
+namespace Felt
+{
+namespace Impl
+{
+namespace Pyramid
+{
+
+/**
+ * Hierarchy of grids counting the number of occupied cells beneath each node.
+ *
+ * Level 0 is a grid of flags (0 or 1), one per cell of the grid being summarised (e.g. the
+ * spatial partitions of a partitioned grid). Each subsequent level halves the resolution along
+ * every axis, with each node storing the number of occupied level 0 cells within the block it
+ * covers, until a single node covers the entire grid.
+ *
+ * Allows queries to skip large empty blocks in O(log n) rather than visiting every cell.
+ *
+ * Positions are given relative to the lower corner of the level 0 grid, i.e. the level 0 grid has
+ * zero offset.
+ *
+ * @tparam D dimension of the grid.
+ */
+template <Dim D>
+class Occupancy
+{
+private:
+	/// D-dimensional integer vector.
+	using VecDi = Felt::VecDi<D>;
+	/// Grid for a single level of the hierarchy.
+	using Level = Impl::Grid::Simple<ListIdx, D>;
+
+	/// Levels of the hierarchy, finest first.
+	std::vector<Level> m_levels;
+
+public:
+	/**
+	 * Construct a hierarchy with nothing occupied.
+	 *
+	 * @param size_ size of level 0 (finest) grid.
+	 */
+	Occupancy(const VecDi& size_)
+	{
+		VecDi size = size_;
+		m_levels.emplace_back(size, VecDi::Zero(), 0);
+
+		while ((size.array() > 1).any())
+		{
+			size = (size + VecDi::Constant(1)) / 2;
+			m_levels.emplace_back(size, VecDi::Zero(), 0);
+		}
+	}
+
+	/**
+	 * Get number of levels in the hierarchy.
+	 *
+	 * @return number of levels, including level 0.
+	 */
+	ListIdx num_levels() const
+	{
+		return m_levels.size();
+	}
+
+	/**
+	 * Get number of occupied level 0 cells beneath a node.
+	 *
+	 * @param pos_ position of node within given level.
+	 * @param level_ level of hierarchy.
+	 * @return number of occupied cells.
+	 */
+	ListIdx count(const VecDi& pos_, const ListIdx level_) const
+	{
+		return m_levels[level_].get(pos_);
+	}
+
+	/**
+	 * Get size of grid at a given level.
+	 *
+	 * @param level_ level of hierarchy.
+	 * @return size of grid.
+	 */
+	const VecDi& size(const ListIdx level_) const
+	{
+		return m_levels[level_].size();
+	}
+
+	/**
+	 * Check whether a level 0 cell is occupied.
+	 *
+	 * @param pos_ position of level 0 cell.
+	 * @return true if occupied, false otherwise.
+	 */
+	bool is_occupied(const VecDi& pos_) const
+	{
+		return bool(m_levels[0].get(pos_));
+	}
+
+	/**
+	 * Get the coarsest level at which the block containing a level 0 cell is entirely empty.
+	 *
+	 * @param pos_ position of level 0 cell.
+	 * @return coarsest empty level, or null_idx if the cell itself is occupied.
+	 */
+	ListIdx empty_level(const VecDi& pos_) const
+	{
+		ListIdx level_empty = null_idx;
+
+		for (ListIdx level = 0; level < m_levels.size(); level++)
+		{
+			if (m_levels[level].get(block(pos_, level)))
+				break;
+			level_empty = level;
+		}
+
+		return level_empty;
+	}
+
+	/**
+	 * Get position of the node at a given level containing a level 0 cell.
+	 *
+	 * @param pos_ position of level 0 cell.
+	 * @param level_ level of hierarchy.
+	 * @return position of node within level.
+	 */
+	static VecDi block(const VecDi& pos_, const ListIdx level_)
+	{
+		VecDi pos_block;
+		for (Dim axis = 0; axis < D; axis++)
+			pos_block(axis) = pos_(axis) >> level_;
+		return pos_block;
+	}
+
+	/**
+	 * Mark a level 0 cell as occupied or not, updating counts up the hierarchy.
+	 *
+	 * @param pos_ position of level 0 cell.
+	 * @param is_occupied_ whether the cell is occupied.
+	 */
+	void occupy(const VecDi& pos_, const bool is_occupied_)
+	{
+		if (is_occupied(pos_) == is_occupied_)
+			return;
+
+		for (ListIdx level = 0; level < m_levels.size(); level++)
+		{
+			const VecDi& pos_block = block(pos_, level);
+			const ListIdx count = m_levels[level].get(pos_block);
+			m_levels[level].set(pos_block, is_occupied_ ? count + 1 : count - 1);
+		}
+	}
+
+	/**
+	 * Mark all cells as unoccupied.
+	 */
+	void reset()
+	{
+		for (Level& level : m_levels)
+			level.data().assign(level.data().size(), 0);
+	}
+};
+
+} // Pyramid.
+} // Impl.
+} // Felt.
+
+#endif /* INCLUDE_FELT_IMPL_PYRAMID_HPP_ */
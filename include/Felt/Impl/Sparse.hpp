@@ -0,0 +1,405 @@
+#ifndef INCLUDE_FELT_IMPL_SPARSE_HPP_
+#define INCLUDE_FELT_IMPL_SPARSE_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <Felt/Impl/Common.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define FELT_SPARSE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Felt
+{
+namespace Impl
+{
+/**
+ * Compact binary snapshot format, storing only the narrow band of active spatial partitions.
+ *
+ * Layout:
+ *
+ * - `Header`.
+ * - `Entry` table, one per stored partition, sorted by partition position index, starting on an
+ *   `alignment` byte boundary.
+ * - Partition payloads, each starting on an `alignment` byte boundary.
+ *
+ * Partitions that are inactive with the default (outside) background value are not stored at all.
+ * Inactive partitions with a different background (e.g. deep inside the surface) are stored as
+ * an entry with an empty payload.
+ *
+ * Partition payloads are encoded with one of the `Codec`s, recorded in the header.
+ *
+ * Values are stored in native byte order.
+ *
+ * A delta checkpoint uses the same layout, identified by `magic_delta`, but stores only the
+ * partitions changed since the previous checkpoint, including those that became inactive.
+ * Checkpoints are appended one after another to a single stream, each padded to an `alignment`
+ * byte boundary, with offsets relative to the start of the checkpoint.
+ *
+ * Since the header and table have fixed layouts and payloads are aligned, a snapshot file can be
+ * memory mapped (see `Mapping`) and payloads decoded in place, on demand.
+ */
+namespace Sparse
+{
+
+/// Identifies a sparse snapshot.
+static constexpr char magic[8] = {'F', 'E', 'L', 'T', 'S', 'P', 'R', 'S'};
+/// Identifies a delta checkpoint.
+static constexpr char magic_delta[8] = {'F', 'E', 'L', 'T', 'D', 'L', 'T', 'A'};
+/// Version of the format.
+static constexpr std::uint32_t version = 2;
+/// Byte boundary that partition payloads are aligned to.
+static constexpr std::uint64_t alignment = 8;
+
+/**
+ * Encoding of partition payloads.
+ */
+enum class Codec : std::uint32_t
+{
+	/**
+	 * Lossless, for fast encoding and decoding.
+	 *
+	 * - Number of narrow band points in each layer.
+	 * - `Leaf` for each narrow band point, grouped by layer.
+	 * - Bitmask flagging which points are inside the surface.
+	 */
+	raw = 0,
+	/**
+	 * Smaller, at the cost of some CPU and quantisation of distance values.
+	 *
+	 * - Run-length encoding of the class of each point (outside, inside or narrow band), in
+	 *   position order, as varints of `(length << 2) | class`.
+	 * - Distance value of each narrow band point, in position order, quantised to a multiple of
+	 *   the header's `quantum` and split into its layer and the (quantised) offset from the
+	 *   layer's integer value. Both are stored as the difference from the previous narrow band
+	 *   point, zigzag encoded and packed as `offset * (4L + 1) + layer` into a single varint. For
+	 *   integral distances each point therefore takes a single byte.
+	 */
+	compact = 1
+};
+
+/// Default quantisation step of distance values in the `compact` codec.
+static constexpr float quantum_default = 1.0f / 4096;
+
+/**
+ * Fixed-size header describing the grid.
+ *
+ * @tparam D dimension of grid.
+ */
+template <Dim D>
+struct Header
+{
+	/// Must match `Sparse::magic`.
+	char			magic[8];
+	/// Must match `Sparse::version`.
+	std::uint32_t	version;
+	/// Dimension of grid.
+	std::uint32_t	dims;
+	/// Number of narrow band layers (tracking lists).
+	std::uint32_t	num_lists;
+	/// Number of entries in the partition table.
+	std::uint32_t	num_entries;
+	/// Size of grid.
+	std::int32_t	size[D];
+	/// Offset of grid.
+	std::int32_t	offset[D];
+	/// Size of each spatial partition.
+	std::int32_t	child_size[D];
+	/// Background value of partitions not stored.
+	float			background;
+	/// Encoding of partition payloads.
+	Codec			codec;
+	/// Quantisation step of distance values, if applicable to the codec.
+	float			quantum;
+};
+
+/**
+ * Partition table entry, locating a partition's payload.
+ */
+struct Entry
+{
+	/// Position index of partition within the children grid.
+	std::uint32_t	pos_idx_child;
+	/// Background value of partition.
+	float			background;
+	/// Byte offset of payload from the start of the snapshot.
+	std::uint64_t	offset;
+	/// Size of payload in bytes, zero if the partition is inactive.
+	std::uint64_t	size;
+};
+
+/**
+ * Narrow band point within a partition payload.
+ */
+struct Leaf
+{
+	/// Position index of point within partition.
+	std::uint32_t	pos_idx;
+	/// Value at point.
+	float			value;
+};
+
+/**
+ * Round a byte offset up to the next payload boundary.
+ *
+ * @param offset_ byte offset.
+ * @return aligned byte offset.
+ */
+inline std::uint64_t align(const std::uint64_t offset_)
+{
+	return (offset_ + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * Append raw bytes of an array of plain values to a byte buffer.
+ *
+ * @param bytes_ buffer to append to.
+ * @param vals_ pointer to first value.
+ * @param num_vals_ number of values.
+ */
+template <typename T>
+void append(std::vector<char>& bytes_, const T* vals_, const ListIdx num_vals_)
+{
+	const ListIdx size = bytes_.size();
+	bytes_.resize(size + num_vals_ * sizeof(T));
+	if (num_vals_)
+		std::memcpy(bytes_.data() + size, vals_, num_vals_ * sizeof(T));
+}
+
+/**
+ * Read plain values from a byte buffer, advancing a cursor.
+ *
+ * @param cursor_ current position in buffer, advanced past the values read.
+ * @param end_ end of buffer.
+ * @param vals_ pointer to first value to populate.
+ * @param num_vals_ number of values.
+ */
+template <typename T>
+void extract(const char*& cursor_, const char* end_, T* vals_, const ListIdx num_vals_)
+{
+	if (ListIdx(end_ - cursor_) < num_vals_ * sizeof(T))
+	{
+		std::stringstream sstr;
+		sstr << "Sparse snapshot payload truncated: expected " << num_vals_ * sizeof(T) <<
+			" bytes but only " << (end_ - cursor_) << " remain";
+		std::string str = sstr.str();
+		throw std::domain_error(str);
+	}
+
+	if (num_vals_)
+		std::memcpy(vals_, cursor_, num_vals_ * sizeof(T));
+	cursor_ += num_vals_ * sizeof(T);
+}
+
+/**
+ * Append an unsigned integer to a byte buffer as a variable length (LEB128) integer, using 7
+ * bits per byte.
+ *
+ * @param bytes_ buffer to append to.
+ * @param val_ value to append.
+ */
+inline void append_varint(std::vector<char>& bytes_, std::uint64_t val_)
+{
+	while (val_ >= 0x80)
+	{
+		bytes_.push_back(char((val_ & 0x7F) | 0x80));
+		val_ >>= 7;
+	}
+	bytes_.push_back(char(val_));
+}
+
+/**
+ * Read a variable length (LEB128) unsigned integer from a byte buffer, advancing a cursor.
+ *
+ * @param cursor_ current position in buffer, advanced past the value read.
+ * @param end_ end of buffer.
+ * @return value read.
+ */
+inline std::uint64_t extract_varint(const char*& cursor_, const char* end_)
+{
+	std::uint64_t val = 0;
+	for (Dim shift = 0; ; shift += 7)
+	{
+		if (cursor_ == end_)
+			throw std::domain_error("Sparse snapshot payload truncated within a varint");
+		if (shift >= 64)
+			throw std::domain_error("Sparse snapshot payload has an overlong varint");
+
+		const std::uint8_t byte = std::uint8_t(*cursor_++);
+		val |= std::uint64_t(byte & 0x7F) << shift;
+		if (!(byte & 0x80))
+			return val;
+	}
+}
+
+/**
+ * Map a signed integer to unsigned, such that values of small magnitude map to small values.
+ *
+ * @param val_ signed value.
+ * @return unsigned value.
+ */
+inline std::uint64_t zigzag(const std::int64_t val_)
+{
+	return (std::uint64_t(val_) << 1) ^ std::uint64_t(val_ >> 63);
+}
+
+/**
+ * Reverse `zigzag`.
+ *
+ * @param val_ unsigned value.
+ * @return signed value.
+ */
+inline std::int64_t unzigzag(const std::uint64_t val_)
+{
+	return std::int64_t(val_ >> 1) ^ -std::int64_t(val_ & 1);
+}
+
+/**
+ * Check that a header describes a snapshot compatible with a grid.
+ *
+ * @param header_ header read from snapshot.
+ * @param num_lists_ number of tracking lists of the grid to load into.
+ * @param magic_ expected identifier, i.e. `magic` or `magic_delta`.
+ */
+template <Dim D>
+void check(const Header<D>& header_, const TupleIdx num_lists_, const char* magic_ = magic)
+{
+	if (std::memcmp(header_.magic, magic_, sizeof(magic)) != 0 || header_.version != version)
+	{
+		throw std::domain_error(
+			std::memcmp(magic_, magic_delta, sizeof(magic)) == 0 ?
+				"Not a sparse delta checkpoint, or unsupported version" :
+				"Not a sparse snapshot, or unsupported version"
+		);
+	}
+
+	if (header_.dims != std::uint32_t(D) || header_.num_lists != std::uint32_t(num_lists_))
+	{
+		std::stringstream sstr;
+		sstr << "Sparse snapshot of " << header_.dims << "D grid with " << header_.num_lists <<
+			" layers cannot be loaded into " << D << "D grid with " << num_lists_ << " layers";
+		std::string str = sstr.str();
+		throw std::domain_error(str);
+	}
+
+	for (Dim axis = 0; axis < D; axis++)
+	{
+		if (header_.size[axis] <= 0 || header_.child_size[axis] <= 0)
+			throw std::domain_error("Sparse snapshot has an empty grid or partition size");
+	}
+
+	if (header_.codec != Codec::raw && header_.codec != Codec::compact)
+		throw std::domain_error("Sparse snapshot uses an unknown codec");
+
+	if (header_.codec == Codec::compact && !(header_.quantum > 0))
+		throw std::domain_error("Sparse snapshot has a non-positive quantisation step");
+}
+
+/**
+ * Read-only view of an entire snapshot file in memory.
+ *
+ * Where available the file is memory mapped, so pages are only read from disk when first
+ * accessed. Otherwise the file is read into a buffer up front.
+ */
+class Mapping
+{
+private:
+	/// Start of file contents.
+	const char*			m_data;
+	/// Size of file in bytes.
+	std::uint64_t		m_size;
+	/// Fallback storage if memory mapping is unavailable.
+	std::vector<char>	m_buffer;
+
+public:
+	/**
+	 * Map a file into memory.
+	 *
+	 * @param path_ path of file to map.
+	 */
+	Mapping(const std::string& path_) : m_data{nullptr}, m_size{0}
+	{
+		#ifdef FELT_SPARSE_MMAP
+		const int fd = ::open(path_.c_str(), O_RDONLY);
+		struct stat status;
+		if (fd < 0 || ::fstat(fd, &status) != 0)
+		{
+			if (fd >= 0)
+				::close(fd);
+			throw std::domain_error("Failed to open sparse snapshot " + path_);
+		}
+		m_size = std::uint64_t(status.st_size);
+		if (m_size)
+		{
+			void* pdata = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (pdata == MAP_FAILED)
+			{
+				::close(fd);
+				throw std::domain_error("Failed to map sparse snapshot " + path_);
+			}
+			m_data = static_cast<const char*>(pdata);
+		}
+		// The mapping remains valid after the file is closed.
+		::close(fd);
+		#else
+		std::ifstream file{path_, std::ios::binary};
+		if (!file)
+			throw std::domain_error("Failed to open sparse snapshot " + path_);
+		m_buffer.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+		m_data = m_buffer.data();
+		m_size = m_buffer.size();
+		#endif
+	}
+
+	Mapping(const Mapping&) = delete;
+	Mapping& operator=(const Mapping&) = delete;
+
+	/**
+	 * Unmap the file.
+	 */
+	~Mapping()
+	{
+		#ifdef FELT_SPARSE_MMAP
+		if (m_data)
+			::munmap(const_cast<char*>(m_data), m_size);
+		#endif
+	}
+
+	/**
+	 * Get start of file contents.
+	 *
+	 * @return pointer to first byte.
+	 */
+	const char* data() const
+	{
+		return m_data;
+	}
+
+	/**
+	 * Get size of file.
+	 *
+	 * @return size in bytes.
+	 */
+	std::uint64_t size() const
+	{
+		return m_size;
+	}
+};
+
+} // Sparse.
+} // Impl.
+} // Felt.
+
+#endif /* INCLUDE_FELT_IMPL_SPARSE_HPP_ */
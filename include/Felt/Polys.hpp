@@ -1,10 +1,21 @@
 #ifndef INCLUDE_FELT_POLYS_HPP_
 #define INCLUDE_FELT_POLYS_HPP_
 
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <Felt/Impl/Common.hpp>
 #include <Felt/Impl/Mixin/PartitionedMixin.hpp>
 #include <Felt/Impl/Mixin/PolyMixin.hpp>
 #include <Felt/Impl/Poly.hpp>
+#include <Felt/Surface.hpp>
 
 
 namespace Felt
@@ -16,8 +27,8 @@ namespace Felt
  * Holds child `Poly::Single` objects that are dynamically created, updated and destroyed as the
  * surface changes.
  *
- * Call `notify` each time the surface is updated to keep track of spatial partitions that need
- * (re)polygonising.
+ * Call `notify` each time the surface is updated to keep track of spatial partitions (and points
+ * within them) that need (re)polygonising.
  *
  * Alternatively call `invalidate` to mark the whole isogrid for (re)polygonisation.
  *
@@ -25,12 +36,29 @@ namespace Felt
  * partitions.
  *
  * After each `march`, call `changes` to get the position indices of partitions that were updated.
+ *
+ * Alternatively call `march_async` to polygonise on a background thread, allowing the next surface
+ * update to proceed concurrently, then `wait` before using the result. The `Polys` object must not
+ * be moved whilst a background polygonisation is in progress.
+ *
+ * Optionally call `weld` to combine the child polygonisations into a single mesh, where vertices
+ * shared by neighbouring partitions are stored only once.
+ *
+ * Alternatively call `flatten` to copy the child polygonisations into flat buffers suitable for
+ * uploading to a renderer.
+ *
+ * Distant partitions can be polygonised at a coarser level of detail by setting their `stride`,
+ * e.g. via a `lod` callback based on camera distance.
+ *
+ * @tparam TSurface surface type to polygonise.
+ * @tparam TChild child poly type, i.e. `Impl::Poly::Single` (dense vertex cache),
+ * 	`Impl::Poly::Hashed` (sparse vertex cache) or `Impl::Poly::Nets` (surface nets).
  */
-template <class TSurface>
-class Polys : private Impl::Mixin::Partitioned::Children< Polys<TSurface> >
+template <class TSurface, class TChild = Impl::Poly::Single<typename TSurface::IsoGrid>>
+class Polys : private Impl::Mixin::Partitioned::Children< Polys<TSurface, TChild> >
 {
 private:
-	using This = Polys<TSurface>;
+	using This = Polys<TSurface, TChild>;
 	using Traits = Impl::Traits<This>;
 
 	using ChildrenImpl = Impl::Mixin::Partitioned::Children<This>;
@@ -40,6 +68,27 @@ private:
 public:
 	/// Child grid type.
 	using Child = typename Traits::Child;
+	/// Strategy for choosing which cubes to polygonise.
+	using March = Impl::Poly::March;
+	/// Policy for calculating vertex normals.
+	using Normals = Impl::Poly::Normals;
+	/// Vertex type.
+	using Vertex = typename Child::Vertex;
+	/// Simplex type.
+	using Simplex = typename Child::Simplex;
+
+	/**
+	 * Flat mesh buffers, with vertex positions and normals in separate contiguous arrays.
+	 */
+	struct Flat
+	{
+		/// Vertex positions, `D` components per vertex.
+		std::vector<Distance>	pos;
+		/// Vertex normals, `D` components per vertex (3D only).
+		std::vector<Distance>	norm;
+		/// Vertex indices of simplices, `D` per simplex, indexing into the whole mesh.
+		std::vector<ListIdx>	idxs;
+	};
 private:
 	/// Isogrid to (partially) polygonise.
 	using IsoGrid = typename Traits::IsoGrid;
@@ -48,17 +97,56 @@ private:
 	/// Lookup grid to track partitions containing zero-layer points.
 	using ChangesGrid = Impl::Lookup::SingleListSingleIdx<Impl::Traits<IsoGrid>::t_dims>;
 
+	/// Dimension of grid.
+	static constexpr Dim t_dims = Traits::t_dims;
+	/// Integer vector.
+	using VecDi = Felt::VecDi<t_dims>;
+
 	Surface const* m_psurface;
 	std::unique_ptr<ChangesGrid> m_pgrid_update_pending;
 	std::unique_ptr<ChangesGrid> m_pgrid_update_done;
 
+	/// Welded vertex array, combining vertices shared between neighbouring partitions.
+	std::vector<Vertex>		m_a_vtx_weld;
+	/// Welded simplex array, indexing into welded vertex array.
+	std::vector<Simplex>	m_a_spx_weld;
+	/// Per-partition map of partition-local vertex index to welded vertex index.
+	std::vector<std::vector<ListIdx>>	m_a_vtx_idxs_weld;
+	/// Per-partition list of the partition owning each partition-local vertex.
+	std::vector<PosIdxList>	m_a_vtx_owners_weld;
+	/// Position indices of partitions included in the last `weld`.
+	PosIdxList				m_pos_idxs_child_weld;
+	/// Estimated workload and position index of each partition to polygonise in `march`.
+	std::vector<std::pair<ListIdx, PosIdx>>	m_pos_idxs_child_march;
+	/// Whether changed points are recorded for `dirty` marches, enabled by the first one.
+	bool					m_is_dirty_tracked;
+	/// Copy of the isogrid for polygonising concurrently with surface updates, see `march_async`.
+	std::unique_ptr<IsoGrid>		m_pisogrid_async;
+	/// Isogrid partitions that have changed since last copied to the asynchronous isogrid.
+	std::unique_ptr<ChangesGrid>	m_pgrid_update_async;
+	/// Offset of each partition's vertices in flat buffers, with the total as the last element.
+	std::vector<ListIdx>	m_vtx_offsets_flat;
+	/// Offset of each partition's simplices in flat buffers, with the total as the last element.
+	std::vector<ListIdx>	m_spx_offsets_flat;
+	/// Library-owned flat buffers, populated by `flatten`.
+	Flat					m_flat;
+	/// Completion of a background polygonisation started by `march_async`. Declared last, so
+	/// that it is destroyed (waiting for completion) before any data the polygonisation uses.
+	std::future<void>		m_future_march;
+
 public:
 	using ChildrenImpl::children;
 
-	Polys(const TSurface& surface_) :
+	/**
+	 * Construct a polygonisation of a surface.
+	 *
+	 * @param surface_ surface to polygonise.
+	 * @param normals_ policy for calculating vertex normals.
+	 */
+	Polys(const TSurface& surface_, const Normals normals_ = Normals::eager) :
 		ChildrenImpl{
 			surface_.isogrid().size(), surface_.isogrid().offset(), surface_.isogrid().child_size(),
-			Child(surface_.isogrid())
+			Child(surface_.isogrid(), normals_)
 		},
 		m_psurface{&surface_},
 		m_pgrid_update_pending{
@@ -70,7 +158,10 @@ public:
 			std::make_unique<ChangesGrid>(
 				surface_.isogrid().children().size(), surface_.isogrid().children().offset()
 			)
-		}
+		},
+		m_a_vtx_idxs_weld(surface_.isogrid().children().data().size()),
+		m_a_vtx_owners_weld(surface_.isogrid().children().data().size()),
+		m_is_dirty_tracked{false}
 	{
 		// Bind child polygonisation to isogrid child.
 		for (
@@ -88,11 +179,16 @@ public:
 	 *
 	 * This should be called whenever the surface is updated to ensure that eventual
 	 * re-polygonisation only needs to update those spatial partitions that have actually changed.
+	 *
+	 * Waits for any background polygonisation to complete.
 	 */
 	void notify()
 	{
 		static const TupleIdx num_lists = m_psurface->isogrid().children().lookup().num_lists;
 
+		wait();
+		notify_async();
+
 		// Cycle outermost bands of delta update spatial partitions. We have three cases:
 		// * Partition is currently polygonised, and since its in the delta grid it needs updating.
 		// * Partition is not currently polygonised, but isogrid is tracking it, in which case it
@@ -130,53 +226,129 @@ public:
 					m_pgrid_update_pending->track(pos_idx_child);
 			}
 		}
+
+		notify_dirty();
 	}
 
 	/**
 	 * Repolygonise partitions marked as changed since last polygonisation.
+	 *
+	 * Partitions vary greatly in the number of cubes to polygonise, so they are ordered by
+	 * decreasing number of narrow band points and handed out to threads dynamically, so that the
+	 * largest start first and smaller ones fill in the gaps. If fewer than
+	 * `FELT_POLYS_OMP_MIN_CHILDS` partitions have changed, then they are polygonised serially to
+	 * avoid the threading overhead.
+	 *
+	 * @param march_ strategy for choosing which cubes to polygonise.
 	 */
-	void march()
+	void march(const March march_ = March::all)
 	{
-		#pragma omp parallel for
-		for (ListIdx list_idx = 0; list_idx < m_pgrid_update_pending->list().size(); list_idx++)
-		{
-			const PosIdx pos_idx_child = m_pgrid_update_pending->list()[list_idx];
+		wait();
+		track_dirty(march_);
+		sync();
+		march_start();
+		march_changes(march_);
+	}
 
-			Child& child = this->children().get(pos_idx_child);
+	/**
+	 * Repolygonise partitions marked as changed since last polygonisation on a background thread.
+	 *
+	 * On first call, a full copy of the whole isogrid is made eagerly and child polys are bound to
+	 * it. The copy is kept for the lifetime of this object, so memory use for the isogrid is
+	 * roughly doubled. On subsequent calls, the partitions that changed since the last march are
+	 * synchronised into the copy before the background thread is started. Polygonisation then
+	 * reads only the copy, so the surface can be updated concurrently.
+	 *
+	 * Call `wait` before accessing the polygonisation. `notify` and `march` (amongst others) wait
+	 * automatically, so the typical frame loop is `update`, `notify`, `march_async`.
+	 *
+	 * The background thread refers to this object, so it must not be moved until the march has
+	 * completed. Changes to the surface made other than by `update` must be followed by
+	 * `invalidate`, so they are copied across.
+	 *
+	 * @param march_ strategy for choosing which cubes to polygonise.
+	 */
+	void march_async(const March march_ = March::all)
+	{
+		wait();
+		track_dirty(march_);
 
-			// If isogrid child partition is active, then polygonise it.
-			if (m_psurface->isogrid().children().get(pos_idx_child).is_active())
-			{
-				if (child.is_active())
-					child.reset();
-				else
-					child.activate();
-				child.march();
+		if (!m_pisogrid_async)
+		{
+			const IsoGrid& isogrid = m_psurface->isogrid();
+			m_pisogrid_async = std::make_unique<IsoGrid>(
+				isogrid.size(), isogrid.offset(), isogrid.child_size(),
+				isogrid.children().get(0).background()
+			);
+			m_pisogrid_async->children() = isogrid.children();
+			m_pgrid_update_async = std::make_unique<ChangesGrid>(
+				isogrid.children().size(), isogrid.children().offset()
+			);
 
-			} else {
-				// Otherwise isogrid child partition has become inactive, so destroy the poly child.
-				if (child.is_active())
-					child.deactivate();
+			for (
+				PosIdx pos_idx_child = 0; pos_idx_child < this->children().data().size();
+				pos_idx_child++
+			) {
+				this->children().get(pos_idx_child).bind(
+					*m_pisogrid_async, m_pisogrid_async->children().get(pos_idx_child).lookup()
+				);
 			}
 		}
 
-		std::swap(m_pgrid_update_pending, m_pgrid_update_done);
-		m_pgrid_update_pending->reset();
+		sync();
+		march_start();
+		m_future_march = std::async(
+			std::launch::async, [this, march_]() { march_changes(march_); }
+		);
+	}
+
+	/**
+	 * Wait for a background polygonisation started by `march_async` to complete.
+	 *
+	 * Rethrows any exception raised during polygonisation.
+	 */
+	void wait()
+	{
+		if (m_future_march.valid())
+			m_future_march.get();
 	}
 
 
 	/**
 	 * Add all active poly childs and isogrid childs to change tracking for (re)polygonisation.
+	 *
+	 * Any surface partitions pending materialisation from a memory mapped snapshot are
+	 * materialised first. If `march_async` has been used, the whole isogrid is copied again
+	 * before the next march, so changes made other than by `update` (e.g. `seed`) are picked up.
 	 */
 	void invalidate()
 	{
 		static const TupleIdx num_lists = m_psurface->isogrid().children().lookup().num_lists;
 
+		wait();
+
+		// Partitions lazily loaded from a memory mapped snapshot are only tracked once they are
+		// in the isogrid.
+		m_psurface->materialise();
+
+		// Any partition of the asynchronous isogrid may be stale.
+		if (m_pisogrid_async)
+		{
+			for (
+				PosIdx pos_idx_child = 0; pos_idx_child < this->children().data().size();
+				pos_idx_child++
+			)
+				m_pgrid_update_async->track(pos_idx_child);
+		}
+
 		// Remove pending changes, we're about to reconstruct the list.
 		m_pgrid_update_pending->reset();
 		// Flag curently active Poly::Single childs for re-polygonisation (or deactivation).
 		for (const PosIdx pos_idx_child : this->children().lookup().list())
 			m_pgrid_update_pending->track(pos_idx_child);
+		// Ensure a subsequent `dirty` march re-polygonises whole partitions.
+		for (Child& child : this->children().data())
+			child.invalidate();
 
 		// Flag active outer-layer isogrid childs for re-polygonisation.
 		for (TupleIdx layer_idx = 0; layer_idx <= num_lists; layer_idx += num_lists - 1)
@@ -190,15 +362,648 @@ public:
 		}
 	}
 
+	/**
+	 * Set the level of detail of a partition, as the number of grid nodes spanned by each cube.
+	 *
+	 * If changed, the partition is flagged for re-polygonisation on the next `march`. Coarser
+	 * partitions hang skirts from their boundary to hide cracks where they meet finer partitions.
+	 *
+	 * @param pos_idx_child_ position index of partition.
+	 * @param stride_ stride between sampled grid nodes (e.g. 1, 2 or 4), which must divide the
+	 * 	partition size.
+	 */
+	void stride(const PosIdx pos_idx_child_, const NodeIdx stride_)
+	{
+		wait();
+		Child& child = this->children().get(pos_idx_child_);
+		if (child.stride() == stride_)
+			return;
+		child.stride(stride_);
+		if (child.is_active())
+			m_pgrid_update_pending->track(pos_idx_child_);
+	}
+
+	/**
+	 * Get the level of detail of a partition.
+	 *
+	 * @param pos_idx_child_ position index of partition.
+	 * @return number of grid nodes spanned by each cube along each axis.
+	 */
+	NodeIdx stride(const PosIdx pos_idx_child_) const
+	{
+		return this->children().get(pos_idx_child_).stride();
+	}
+
+	/**
+	 * Set the level of detail of every partition using a callback, e.g. based on camera distance.
+	 *
+	 * @param fn_ callback taking the offset and size of a partition and returning its stride.
+	 */
+	template <typename Fn>
+	void lod(Fn&& fn_)
+	{
+		const auto& isochildren = m_psurface->isogrid().children();
+
+		for (PosIdx pos_idx_child = 0; pos_idx_child < isochildren.data().size(); pos_idx_child++)
+		{
+			const IsoChild& isochild = isochildren.get(pos_idx_child);
+			stride(pos_idx_child, fn_(isochild.offset(), isochild.size()));
+		}
+	}
+
 	/**
 	 * Get list of partitions that were updated.
 	 *
+	 * The ranges of vertex and simplex slots that were modified within each of these partitions
+	 * are given by the partition's `vtx_spans` and `spx_spans`.
+	 *
 	 * @return list of position indices of partitions that were repolygonised in the last `march`.
 	 */
 	const PosIdxList& changes() const
 	{
 		return m_pgrid_update_done->list();
 	}
+
+	/**
+	 * Get estimated workload of each partition repolygonised in the last `march`.
+	 *
+	 * @return pairs of number of narrow band points and position index of partition, in the
+	 * 	order they were handed out to threads, i.e. by decreasing workload.
+	 */
+	const std::vector<std::pair<ListIdx, PosIdx>>& workloads() const
+	{
+		return m_pos_idxs_child_march;
+	}
+
+	/**
+	 * Combine the polygonisations of all active partitions into a single welded mesh.
+	 *
+	 * Neighbouring child polys overlap, so vertices along shared faces are calculated and stored
+	 * by each partition that uses them. Each such vertex is assigned to the partition with the
+	 * lowest position index that holds it, and only that partition contributes it to the welded
+	 * vertex array.
+	 *
+	 * The welded mesh is available via `vtxs` and `spxs`, and the mapping from each partition's
+	 * own vertex indices to welded vertex indices via `vtx_idxs`.
+	 *
+	 * All partitions must be polygonised at full resolution, i.e. a `stride` of 1.
+	 */
+	void weld()
+	{
+		wait();
+		m_pos_idxs_child_weld.clear();
+		for (PosIdx pos_idx_child = 0; pos_idx_child < this->children().data().size(); pos_idx_child++)
+		{
+			if (this->children().get(pos_idx_child).is_active())
+				m_pos_idxs_child_weld.push_back(pos_idx_child);
+			else
+				m_a_vtx_idxs_weld[pos_idx_child].clear();
+		}
+
+		const ListIdx num_childs = m_pos_idxs_child_weld.size();
+
+		// Number of vertices owned by each partition.
+		std::vector<ListIdx> num_vtxs_owned(num_childs);
+
+		// Find the owner of each vertex.
+		#pragma omp parallel for
+		for (ListIdx list_idx = 0; list_idx < num_childs; list_idx++)
+		{
+			const PosIdx pos_idx_child = m_pos_idxs_child_weld[list_idx];
+			const Child& child = this->children().get(pos_idx_child);
+			PosIdxList& vtx_owners = m_a_vtx_owners_weld[pos_idx_child];
+			// Vertex slots released by a `dirty` march are not referenced, so have no owner.
+			vtx_owners.assign(child.vtxs().size(), Felt::null_idx);
+
+			for (ListIdx vtx_idx = 0; vtx_idx < child.vtxs().size(); vtx_idx++)
+			{
+				const PosIdx edge_idx = child.vtx_edges()[vtx_idx];
+				if (edge_idx == Felt::null_idx)
+					continue;
+				vtx_owners[vtx_idx] = owner(
+					pos_idx_child, child.edge_pos(edge_idx), Child::edge_axis(edge_idx)
+				);
+				if (vtx_owners[vtx_idx] == pos_idx_child)
+					num_vtxs_owned[list_idx]++;
+			}
+		}
+
+		// Offsets of each partition's owned vertices and simplices in the welded arrays.
+		std::vector<ListIdx> vtx_offsets(num_childs);
+		std::vector<ListIdx> spx_offsets(num_childs);
+		ListIdx num_vtxs = 0;
+		ListIdx num_spxs = 0;
+		for (ListIdx list_idx = 0; list_idx < num_childs; list_idx++)
+		{
+			vtx_offsets[list_idx] = num_vtxs;
+			spx_offsets[list_idx] = num_spxs;
+			num_vtxs += num_vtxs_owned[list_idx];
+			num_spxs += this->children().get(m_pos_idxs_child_weld[list_idx]).spxs().size();
+		}
+		m_a_vtx_weld.resize(num_vtxs);
+		m_a_spx_weld.resize(num_spxs);
+
+		// Copy owned vertices into the welded array.
+		#pragma omp parallel for
+		for (ListIdx list_idx = 0; list_idx < num_childs; list_idx++)
+		{
+			const PosIdx pos_idx_child = m_pos_idxs_child_weld[list_idx];
+			const Child& child = this->children().get(pos_idx_child);
+			const PosIdxList& vtx_owners = m_a_vtx_owners_weld[pos_idx_child];
+			std::vector<ListIdx>& vtx_idxs = m_a_vtx_idxs_weld[pos_idx_child];
+			vtx_idxs.assign(child.vtxs().size(), Felt::null_idx);
+
+			ListIdx vtx_idx_weld = vtx_offsets[list_idx];
+			for (ListIdx vtx_idx = 0; vtx_idx < child.vtxs().size(); vtx_idx++)
+			{
+				if (vtx_owners[vtx_idx] != pos_idx_child)
+					continue;
+				vtx_idxs[vtx_idx] = vtx_idx_weld;
+				m_a_vtx_weld[vtx_idx_weld] = child.vtxs()[vtx_idx];
+				vtx_idx_weld++;
+			}
+		}
+
+		// Resolve vertices owned by neighbouring partitions, then remap simplices.
+		#pragma omp parallel for
+		for (ListIdx list_idx = 0; list_idx < num_childs; list_idx++)
+		{
+			const PosIdx pos_idx_child = m_pos_idxs_child_weld[list_idx];
+			const Child& child = this->children().get(pos_idx_child);
+			const PosIdxList& vtx_owners = m_a_vtx_owners_weld[pos_idx_child];
+			std::vector<ListIdx>& vtx_idxs = m_a_vtx_idxs_weld[pos_idx_child];
+
+			for (ListIdx vtx_idx = 0; vtx_idx < child.vtxs().size(); vtx_idx++)
+			{
+				const PosIdx pos_idx_owner = vtx_owners[vtx_idx];
+				if (pos_idx_owner == Felt::null_idx || pos_idx_owner == pos_idx_child)
+					continue;
+				const PosIdx edge_idx = child.vtx_edges()[vtx_idx];
+				const ListIdx vtx_idx_owner = this->children().get(pos_idx_owner).vtx_idx(
+					child.edge_pos(edge_idx), Child::edge_axis(edge_idx)
+				);
+				vtx_idxs[vtx_idx] = m_a_vtx_idxs_weld[pos_idx_owner][vtx_idx_owner];
+			}
+
+			ListIdx spx_idx_weld = spx_offsets[list_idx];
+			for (const Simplex& spx : child.spxs())
+			{
+				Simplex& spx_weld = m_a_spx_weld[spx_idx_weld++];
+				for (Dim endpoint = 0; endpoint < t_dims; endpoint++)
+					spx_weld.idxs(endpoint) = vtx_idxs[spx.idxs(endpoint)];
+			}
+		}
+	}
+
+	/**
+	 * Get the welded vertex array.
+	 *
+	 * @return vertices of the mesh constructed by the last `weld`.
+	 */
+	const std::vector<Vertex>& vtxs() const
+	{
+		return m_a_vtx_weld;
+	}
+
+	/**
+	 * Get the welded simplex array.
+	 *
+	 * @return simplices of the mesh constructed by the last `weld`, indexing into `vtxs`.
+	 */
+	const std::vector<Simplex>& spxs() const
+	{
+		return m_a_spx_weld;
+	}
+
+	/**
+	 * Get mapping from a partition's own vertex indices to welded vertex indices.
+	 *
+	 * @param pos_idx_child_ position index of partition.
+	 * @return list of welded vertex indices, indexed by partition-local vertex index.
+	 */
+	const std::vector<ListIdx>& vtx_idxs(const PosIdx pos_idx_child_) const
+	{
+		return m_a_vtx_idxs_weld[pos_idx_child_];
+	}
+
+	/**
+	 * Compute the offset of each partition's vertices and simplices within flat buffers.
+	 *
+	 * Must be called before `flatten` into caller-supplied buffers, which must be large enough to
+	 * hold `flat_num_vtxs` vertices and `flat_num_spxs` simplices.
+	 */
+	void flat_offsets()
+	{
+		wait();
+		const ListIdx num_childs = this->children().data().size();
+
+		m_vtx_offsets_flat.resize(num_childs + 1);
+		m_spx_offsets_flat.resize(num_childs + 1);
+		m_vtx_offsets_flat[0] = 0;
+		m_spx_offsets_flat[0] = 0;
+
+		for (PosIdx pos_idx_child = 0; pos_idx_child < num_childs; pos_idx_child++)
+		{
+			const Child& child = this->children().get(pos_idx_child);
+			m_vtx_offsets_flat[pos_idx_child + 1] =
+				m_vtx_offsets_flat[pos_idx_child] + child.vtxs().size();
+			m_spx_offsets_flat[pos_idx_child + 1] =
+				m_spx_offsets_flat[pos_idx_child] + child.spxs().size();
+		}
+	}
+
+	/**
+	 * Get total number of vertices computed by the last `flat_offsets`.
+	 *
+	 * @return number of vertices.
+	 */
+	ListIdx flat_num_vtxs() const
+	{
+		return m_vtx_offsets_flat.size() ? m_vtx_offsets_flat.back() : 0;
+	}
+
+	/**
+	 * Get total number of simplices computed by the last `flat_offsets`.
+	 *
+	 * @return number of simplices.
+	 */
+	ListIdx flat_num_spxs() const
+	{
+		return m_spx_offsets_flat.size() ? m_spx_offsets_flat.back() : 0;
+	}
+
+	/**
+	 * Copy the polygonisation into caller-supplied flat buffers, in parallel over partitions.
+	 *
+	 * Each partition's vertices and simplices are written at the offsets computed by the last
+	 * call to `flat_offsets`, with simplex vertex indices rebased to index into the whole mesh.
+	 * Vertex slots released by a `dirty` march are copied but not referenced.
+	 *
+	 * Normals are calculated as required by the normals policy.
+	 *
+	 * @param pos_ buffer for `D * flat_num_vtxs()` vertex position components.
+	 * @param norm_ buffer for `D * flat_num_vtxs()` vertex normal components, or nullptr to skip
+	 * 	normals. Must be nullptr for 2D.
+	 * @param idxs_ buffer for `D * flat_num_spxs()` simplex vertex indices.
+	 *
+	 * @throw std::domain_error if the polygonisation has changed since the last `flat_offsets`.
+	 */
+	void flatten(Distance* pos_, Distance* norm_, ListIdx* idxs_)
+	{
+		wait();
+		const ListIdx num_childs = this->children().data().size();
+
+		for (PosIdx pos_idx_child = 0; pos_idx_child < num_childs; pos_idx_child++)
+		{
+			const Child& child = this->children().get(pos_idx_child);
+			if (
+				m_vtx_offsets_flat.size() != num_childs + 1 ||
+				m_vtx_offsets_flat[pos_idx_child + 1] - m_vtx_offsets_flat[pos_idx_child] !=
+					child.vtxs().size() ||
+				m_spx_offsets_flat[pos_idx_child + 1] - m_spx_offsets_flat[pos_idx_child] !=
+					child.spxs().size()
+			) {
+				std::stringstream sstr;
+				sstr << "Partition " << pos_idx_child <<
+					" has changed since flat offsets were computed, call flat_offsets again";
+				std::string str = sstr.str();
+				throw std::domain_error(str);
+			}
+		}
+
+		#pragma omp parallel for
+		for (PosIdx pos_idx_child = 0; pos_idx_child < num_childs; pos_idx_child++)
+		{
+			Child& child = this->children().get(pos_idx_child);
+			const ListIdx vtx_offset = m_vtx_offsets_flat[pos_idx_child];
+			const ListIdx spx_offset = m_spx_offsets_flat[pos_idx_child];
+
+			for (ListIdx vtx_idx = 0; vtx_idx < child.vtxs().size(); vtx_idx++)
+			{
+				const ListIdx flat_idx = (vtx_offset + vtx_idx) * t_dims;
+				for (Dim axis = 0; axis < t_dims; axis++)
+					pos_[flat_idx + axis] = child.vtxs()[vtx_idx].pos(axis);
+				if (norm_)
+					flatten_norm(
+						child, vtx_idx, norm_ + flat_idx, std::integral_constant<bool, t_dims == 3>{}
+					);
+			}
+
+			for (ListIdx spx_idx = 0; spx_idx < child.spxs().size(); spx_idx++)
+			{
+				const ListIdx flat_idx = (spx_offset + spx_idx) * t_dims;
+				for (Dim endpoint = 0; endpoint < t_dims; endpoint++)
+					idxs_[flat_idx + endpoint] = vtx_offset + child.spxs()[spx_idx].idxs(endpoint);
+			}
+		}
+	}
+
+	/**
+	 * Copy the polygonisation into library-owned flat buffers, available via `flat`.
+	 *
+	 * Normals are only exported for 3D.
+	 */
+	void flatten()
+	{
+		flat_offsets();
+		m_flat.pos.resize(flat_num_vtxs() * t_dims);
+		m_flat.norm.resize(t_dims == 3 ? flat_num_vtxs() * t_dims : 0);
+		m_flat.idxs.resize(flat_num_spxs() * t_dims);
+		flatten(
+			m_flat.pos.data(), m_flat.norm.size() ? m_flat.norm.data() : nullptr,
+			m_flat.idxs.data()
+		);
+	}
+
+	/**
+	 * Get library-owned flat buffers populated by the last `flatten`.
+	 *
+	 * @return flat mesh buffers.
+	 */
+	const Flat& flat() const
+	{
+		return m_flat;
+	}
+
+private:
+	/**
+	 * Copy the normal of a vertex into a flat buffer (3D).
+	 *
+	 * @param child_ partition holding vertex.
+	 * @param vtx_idx_ index of vertex within partition.
+	 * @param norm_ location in flat buffer to write to.
+	 */
+	static void flatten_norm(
+		Child& child_, const ListIdx vtx_idx_, Distance* norm_, std::true_type
+	) {
+		const auto& norm = child_.norm(vtx_idx_);
+		for (Dim axis = 0; axis < t_dims; axis++)
+			norm_[axis] = norm(axis);
+	}
+
+	/**
+	 * Normals are not supported in 2D, so do nothing.
+	 */
+	static void flatten_norm(Child&, const ListIdx, Distance*, std::false_type)
+	{}
+
+	/**
+	 * Get the isogrid that child polys read from.
+	 *
+	 * @return copy of isogrid if `march_async` has been used, otherwise surface's isogrid.
+	 */
+	const IsoGrid& isogrid() const
+	{
+		return m_pisogrid_async ? *m_pisogrid_async : m_psurface->isogrid();
+	}
+
+	/**
+	 * Track isogrid partitions that changed in the last surface update, so they can be copied to
+	 * the asynchronous isogrid before the next `march`.
+	 *
+	 * Values change only in partitions with points in the delta grid. Points changing layer can
+	 * cause neighbouring points to be added to the narrow band, so neighbouring partitions of
+	 * those with status changes are also tracked.
+	 */
+	void notify_async()
+	{
+		// Number of neighbouring partitions, including the centre.
+		static const PosIdx num_neighs = PosIdx(std::pow(3, t_dims));
+		static const TupleIdx num_lists = m_psurface->isogrid().children().lookup().num_lists;
+
+		if (!m_pisogrid_async)
+			return;
+
+		const VecDi& pos_child_lower = this->children().offset();
+		const VecDi& pos_child_upper = this->children().offset() + this->children().size();
+
+		for (TupleIdx layer_idx = 0; layer_idx < num_lists; layer_idx++)
+		{
+			for (const PosIdx pos_idx_child : m_psurface->delta(layer_idx))
+				m_pgrid_update_async->track(pos_idx_child);
+
+			for (const PosIdx pos_idx_child : m_psurface->status_change(layer_idx))
+			{
+				const VecDi& pos_child = this->children().index(pos_idx_child);
+
+				for (PosIdx neigh_idx = 0; neigh_idx < num_neighs; neigh_idx++)
+				{
+					VecDi pos_neigh = pos_child;
+					PosIdx neigh_idx_axis = neigh_idx;
+					for (Dim axis = 0; axis < t_dims; axis++)
+					{
+						pos_neigh(axis) += NodeIdx(neigh_idx_axis % 3) - 1;
+						neigh_idx_axis /= 3;
+					}
+
+					if (!Felt::inside(pos_neigh, pos_child_lower, pos_child_upper))
+						continue;
+
+					m_pgrid_update_async->track(this->children().index(pos_neigh));
+				}
+			}
+		}
+	}
+
+	/**
+	 * Copy isogrid partitions that changed since the last `march` to the asynchronous isogrid.
+	 */
+	void sync()
+	{
+		if (!m_pisogrid_async)
+			return;
+
+		const IsoGrid& isogrid = m_psurface->isogrid();
+
+		for (const PosIdx pos_idx_child : m_pgrid_update_async->list())
+			m_pisogrid_async->children().get(pos_idx_child) =
+				isogrid.children().get(pos_idx_child);
+
+		m_pisogrid_async->children().lookup() = isogrid.children().lookup();
+		m_pgrid_update_async->reset();
+	}
+
+	/**
+	 * Take the list of partitions marked as changed, ordering them by estimated workload.
+	 *
+	 * The pending list becomes the list of `changes`, and a new pending list is started, so that
+	 * `notify` can be called whilst a `march_async` is in progress.
+	 */
+	void march_start()
+	{
+		static const TupleIdx num_lists = m_psurface->isogrid().children().lookup().num_lists;
+
+		std::swap(m_pgrid_update_pending, m_pgrid_update_done);
+		m_pgrid_update_pending->reset();
+
+		// Estimate workload of each changed partition.
+		m_pos_idxs_child_march.clear();
+		for (const PosIdx pos_idx_child : m_pgrid_update_done->list())
+		{
+			const IsoChild& isochild = isogrid().children().get(pos_idx_child);
+			ListIdx num_leafs = 0;
+			if (isochild.is_active())
+				for (TupleIdx list_idx = 0; list_idx < num_lists; list_idx++)
+					num_leafs += isochild.lookup().list(list_idx).size();
+			m_pos_idxs_child_march.emplace_back(num_leafs, pos_idx_child);
+		}
+
+		// Largest workload first.
+		std::sort(
+			m_pos_idxs_child_march.begin(), m_pos_idxs_child_march.end(),
+			[](const auto& a_, const auto& b_) { return a_.first > b_.first; }
+		);
+	}
+
+	/**
+	 * Polygonise the partitions gathered by `march_start`.
+	 *
+	 * @param march_ strategy for choosing which cubes to polygonise.
+	 */
+	void march_changes(const March march_)
+	{
+		FELT_POLYS_PARALLEL_FOR(m_pos_idxs_child_march.size(), schedule(dynamic))
+		for (ListIdx list_idx = 0; list_idx < m_pos_idxs_child_march.size(); list_idx++)
+		{
+			const PosIdx pos_idx_child = m_pos_idxs_child_march[list_idx].second;
+
+			Child& child = this->children().get(pos_idx_child);
+
+			// If isogrid child partition is active, then polygonise it.
+			if (isogrid().children().get(pos_idx_child).is_active())
+			{
+				if (!child.is_active())
+					child.activate();
+				else if (march_ != March::dirty)
+					child.reset();
+				child.march(march_);
+
+			} else {
+				// Otherwise isogrid child partition has become inactive, so destroy the poly child.
+				if (child.is_active())
+					child.deactivate();
+			}
+		}
+	}
+
+
+	/**
+	 * Start recording changed points on the first `dirty` march.
+	 *
+	 * No points were recorded before then, so every child poly is forced to re-polygonise its
+	 * whole partition on that first `dirty` march.
+	 *
+	 * @param march_ strategy for choosing which cubes to polygonise.
+	 */
+	void track_dirty(const March march_)
+	{
+		if (march_ != March::dirty || m_is_dirty_tracked)
+			return;
+
+		m_is_dirty_tracked = true;
+		for (Child& child : this->children().data())
+			child.invalidate();
+	}
+
+	/**
+	 * Mark points updated in the last surface update as dirty in the child polys whose cubes
+	 * they are a corner of, and flag those child polys for re-polygonisation.
+	 *
+	 * Only layers within two of the zero-layer are considered, since points further away cannot be
+	 * a corner of a cube containing a zero-crossing, either before or after the update.
+	 *
+	 * Skipped unless a `dirty` march has been requested, so other strategies don't pay for it.
+	 * Flagging every child poly that records a point ensures its list is consumed by the next
+	 * march rather than growing without bound.
+	 */
+	void notify_dirty()
+	{
+		// Number of corners of a cube, which is also the number of partitions sharing a point.
+		static constexpr PosIdx num_corners = 1 << t_dims;
+		static const TupleIdx num_lists = m_psurface->isogrid().children().lookup().num_lists;
+		static const TupleIdx layer_idx_zero = num_lists / 2;
+		static const TupleIdx layer_idx_min = layer_idx_zero - std::min(layer_idx_zero, TupleIdx(2));
+		static const TupleIdx layer_idx_max = std::min(layer_idx_zero + 2, num_lists - 1);
+
+		if (!m_is_dirty_tracked)
+			return;
+
+		const VecDi& pos_child_lower = this->children().offset();
+		const VecDi& pos_child_upper = this->children().offset() + this->children().size();
+
+		for (TupleIdx layer_idx = layer_idx_min; layer_idx <= layer_idx_max; layer_idx++)
+		{
+			for (const PosIdx pos_idx_child : m_psurface->delta(layer_idx))
+			{
+				const IsoChild& isochild = m_psurface->isogrid().children().get(pos_idx_child);
+				const VecDi& pos_child = this->children().index(pos_idx_child);
+
+				for (const PosIdx pos_idx_leaf : m_psurface->delta(pos_idx_child, layer_idx))
+				{
+					const VecDi& pos_leaf = isochild.index(pos_idx_leaf);
+
+					// Cubes are owned by the partition containing their lowest corner, so a point
+					// can be a corner of cubes in this partition and those along negative axes.
+					for (PosIdx corner_idx = 0; corner_idx < num_corners; corner_idx++)
+					{
+						VecDi pos_neigh = pos_child;
+						for (Dim axis = 0; axis < t_dims; axis++)
+							pos_neigh(axis) -= NodeIdx((corner_idx >> axis) & 1);
+
+						if (!Felt::inside(pos_neigh, pos_child_lower, pos_child_upper))
+							continue;
+
+						if (this->children().get(pos_neigh).dirty(pos_leaf))
+							m_pgrid_update_pending->track(this->children().index(pos_neigh));
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * Get the partition that owns the vertex along a given edge.
+	 *
+	 * The owner is the partition with the lowest position index holding a vertex for the edge.
+	 *
+	 * @param pos_idx_child_ position index of a partition holding the vertex.
+	 * @param pos_ lower endpoint of edge.
+	 * @param axis_ axis along which the edge lies.
+	 * @return position index of owning partition.
+	 */
+	PosIdx owner(const PosIdx pos_idx_child_, const VecDi& pos_, const Dim axis_) const
+	{
+		// Number of neighbouring partitions that could overlap a position, including the centre.
+		static const PosIdx num_neighs = PosIdx(std::pow(3, t_dims));
+
+		const VecDi& pos_child = this->children().index(pos_idx_child_);
+		const VecDi& pos_child_lower = this->children().offset();
+		const VecDi& pos_child_upper = this->children().offset() + this->children().size();
+		PosIdx pos_idx_owner = pos_idx_child_;
+
+		for (PosIdx neigh_idx = 0; neigh_idx < num_neighs; neigh_idx++)
+		{
+			VecDi pos_neigh = pos_child;
+			PosIdx neigh_idx_axis = neigh_idx;
+			for (Dim axis = 0; axis < t_dims; axis++)
+			{
+				pos_neigh(axis) += NodeIdx(neigh_idx_axis % 3) - 1;
+				neigh_idx_axis /= 3;
+			}
+
+			if (!Felt::inside(pos_neigh, pos_child_lower, pos_child_upper))
+				continue;
+
+			const PosIdx pos_idx_neigh = this->children().index(pos_neigh);
+			if (pos_idx_neigh >= pos_idx_owner)
+				continue;
+
+			if (this->children().get(pos_idx_neigh).vtx_idx(pos_, axis_) != Felt::null_idx)
+				pos_idx_owner = pos_idx_neigh;
+		}
+
+		return pos_idx_owner;
+	}
 };
 
 namespace Impl
@@ -207,9 +1012,10 @@ namespace Impl
  * Traits for Polys.
  *
  * @tparam Surface surface type to polygonise.
+ * @tparam TChild child poly type.
  */
-template <class TSurface>
-struct Traits< Polys<TSurface> >
+template <class TSurface, class TChild>
+struct Traits< Polys<TSurface, TChild> >
 {
 	/// Type of surface to polygonise.
 	using Surface = TSurface;
@@ -218,7 +1024,7 @@ struct Traits< Polys<TSurface> >
 	/// Dimension of grid.
 	static constexpr Dim t_dims = Traits<IsoGrid>::t_dims;
 	/// Child poly type to polygonise a single spatial partition.
-	using Child = Impl::Poly::Single<IsoGrid>;
+	using Child = TChild;
 	/// Children grid type to store and track active child polys.
 	using Children = Impl::Tracked::SingleListSingleIdxByRef<Child, t_dims>;
 };
@@ -1,15 +1,27 @@
 #ifndef Surface_hpp
 #define Surface_hpp
 #include <Felt/Impl/Common.hpp>
+#include <Felt/Impl/Lookup.hpp>
 #include <Felt/Impl/Partitioned.hpp>
+#include <Felt/Impl/Primitive.hpp>
+#include <Felt/Impl/Pyramid.hpp>
+#include <Felt/Impl/Sparse.hpp>
 #include <Felt/Impl/Util.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <vector>
 #include <functional>
+#include <future>
 #include <limits>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <omp.h>
 #include <iostream>
+#include <string>
+#include <thread>
 
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
@@ -26,6 +38,16 @@
 #define FELT_SURFACE_OMP_MIN_CHUNK_SIZE 32
 #endif
 
+#ifndef FELT_POLYS_OMP_MIN_CHILDS
+/**
+ * Minimum number of changed spatial partitions required before polygonising them in parallel.
+ *
+ * Below this, the partitions are polygonised serially, since the OpenMP overhead would outweigh
+ * the work done by each thread.
+ */
+#define FELT_POLYS_OMP_MIN_CHILDS 3
+#endif
+
 /// Transform args to a char* string.
 #define FELT_STR(args) #args
 /// The OpenMP parallel loop command.
@@ -33,6 +55,11 @@
 	FELT_STR(omp parallel for if(num >= FELT_SURFACE_OMP_MIN_CHUNK_SIZE) __VA_ARGS__)
 /// The #pragma containing the OpenMP parallel loop command
 #define FELT_PARALLEL_FOR(num, ...) _Pragma(FELT_PARALLEL_FOR_CMD(num, __VA_ARGS__))
+/// The OpenMP parallel loop command for polygonising changed spatial partitions.
+#define FELT_POLYS_PARALLEL_FOR_CMD(num, ...)\
+	FELT_STR(omp parallel for if(num >= FELT_POLYS_OMP_MIN_CHILDS) __VA_ARGS__)
+/// The #pragma containing the OpenMP parallel loop command for polygonising partitions.
+#define FELT_POLYS_PARALLEL_FOR(num, ...) _Pragma(FELT_POLYS_PARALLEL_FOR_CMD(num, __VA_ARGS__))
 
 
 namespace Felt
@@ -65,6 +92,16 @@ private:
 	static constexpr LayerId s_num_layers = 2*L+1;
 	/// A tiny number used for error margin when raycasting.
 	static constexpr Distance TINY = 0.00001f;
+	/// Distance from an updated zero-layer point within which an update may modify the isogrid.
+	static constexpr NodeIdx s_update_reach = 2 * s_outside;
+	/// Class of a point beyond the narrow band, outside the surface, in compact snapshots.
+	static constexpr std::uint8_t s_class_outside = 0;
+	/// Class of a point beyond the narrow band, inside the surface, in compact snapshots.
+	static constexpr std::uint8_t s_class_inside = 1;
+	/// Class of a narrow band point in compact snapshots.
+	static constexpr std::uint8_t s_class_band = 2;
+	/// Number of possible (zigzag encoded) differences between layers in compact snapshots.
+	static constexpr std::uint64_t s_layer_deltas = 4 * L + 1;
 	/**
 	 * A delta isogrid update grid with active (non-zero) grid points tracked.
 	 */
@@ -74,7 +111,19 @@ public:
 	 * A level set embedding isogrid grid, with active grid points (the narrow band) tracked.
 	 */
 	using IsoGrid = Impl::Partitioned::Tracked::Numeric<Distance, D, s_num_layers>;
+	/**
+	 * Encoding of partition payloads in sparse snapshots.
+	 */
+	using Codec = Impl::Sparse::Codec;
+	/**
+	 * Primitive shape that can be stamped into the surface.
+	 */
+	using Primitive = Impl::Primitive::Shape<D>;
 private:
+	/**
+	 * A single spatial partition of the isogrid.
+	 */
+	using IsoChild = typename IsoGrid::Child;
 	/**
 	 * D-dimensional integer vector.
 	 */
@@ -97,16 +146,14 @@ private:
 	using StatusChangeGrid = Impl::Partitioned::Tracked::Simple<LayerId, D, s_num_layers>;
 
 	/**
-	 * Structure to store raycast intermediate results.
+	 * Hierarchy over the spatial partitions, flagging those that may contain the zero-curve.
 	 */
-	struct ChildHit
-	{
-		ChildHit(const VecDf& pos_intersect_, PosIdx pos_idx_child_)
-		: pos_intersect(pos_intersect_), pos_idx_child(pos_idx_child_)
-		{}
-		VecDf pos_intersect;
-		PosIdx pos_idx_child;
-	};
+	using Occupancy = Impl::Pyramid::Occupancy<D>;
+	/**
+	 * Lookup over the spatial partitions, tracking those changed since the last checkpoint.
+	 */
+	using DirtyLookupGrid = Impl::Lookup::SingleListSingleIdx<D>;
+
 	/**
 	 * The main level set embedding isogrid.
 	 */
@@ -129,6 +176,75 @@ private:
 	 */
 	AffectedLookupGrid 	m_grid_affected;
 	AffectedLookupGrid 	m_grid_affected_buffer;
+	/**
+	 * Hierarchy of spatial partitions containing points in layers -1, 0 or +1.
+	 *
+	 * Used to skip large regions of empty space when querying the surface.
+	 */
+	Occupancy			m_pyramid;
+	/**
+	 * Spatial partitions changed since the last checkpoint.
+	 */
+	DirtyLookupGrid		m_grid_dirty;
+	/**
+	 * Encoding of partition payloads when saving sparse snapshots.
+	 */
+	Codec				m_codec;
+	/**
+	 * Quantisation step of distance values when saving sparse snapshots, if applicable.
+	 */
+	Distance			m_quantum;
+
+	/**
+	 * Partitions of a memory mapped sparse snapshot, pending materialisation into the isogrid.
+	 */
+	struct Lazy
+	{
+		/// Materialisation state of a partition.
+		enum State : std::uint8_t
+		{
+			/// Partition is in the isogrid (or was never stored lazily).
+			done = 0,
+			/// Partition payload is yet to be decoded.
+			pending,
+			/// Partition payload is being decoded by some thread.
+			busy
+		};
+
+		/// Memory mapped snapshot.
+		Impl::Sparse::Mapping								mapping;
+		/// Encoding of partition payloads.
+		Codec												codec;
+		/// Quantisation step of distance values, if applicable to the codec.
+		Distance											quantum;
+		/// Table entry of each partition, by position index, or null if not stored lazily.
+		std::vector<const Impl::Sparse::Entry*>				pentries;
+		/// Materialisation state of each partition, by position index.
+		std::vector<std::atomic<std::uint8_t>>				states;
+		/// Lock for tracking materialised partitions in the isogrid's children lookup.
+		std::mutex											mutex;
+
+		/**
+		 * Map a snapshot file into memory.
+		 *
+		 * @param path_ path of snapshot file.
+		 */
+		Lazy(const std::string& path_) : mapping{path_}, codec{Codec::raw}, quantum{0}
+		{}
+	};
+
+	/**
+	 * Memory mapped snapshot that partitions are lazily materialised from, if any.
+	 */
+	std::unique_ptr<Lazy>	m_plazy;
+
+	/**
+	 * Background save, if any.
+	 *
+	 * Declared last, so is destroyed first, blocking until the save completes before the copy of
+	 * the isogrid it reads is destroyed.
+	 */
+	std::future<void>		m_future_save;
 
 public:
 	/// D-dimensional hyperplane type (using Eigen library), for raycasting.
@@ -136,6 +252,20 @@ public:
 	/// D-dimensional parameterised line, for raycasting.
 	using Line = Eigen::ParametrizedLine<Distance, D>;
 
+	/**
+	 * Method used to march a ray through the narrow band within a spatial partition.
+	 */
+	enum class RayMarch
+	{
+		/// Sample at fixed half-unit intervals along the ray.
+		fixed,
+		/**
+		 * Use the stored (city-block) distance to the zero-curve to skip ahead by the largest
+		 * safe step, falling back to fixed steps near the zero-layer.
+		 */
+		sphere
+	};
+
 	/**
 	 * Store approximate statistics of the number of spatial partitions using up memory.
 	 */
@@ -147,6 +277,21 @@ public:
 		ListIdx active_delta_partitions;
 	};
 
+	/**
+	 * Result of a closest point query.
+	 */
+	struct Closest
+	{
+		/// Signed distance to the zero-curve, or background value if beyond the narrow band.
+		Distance distance;
+		/// Unit normal to the zero-curve, or zero if beyond the narrow band.
+		VecDf normal;
+		/// Estimate of closest point on the zero-curve, or ray_miss if beyond the narrow band.
+		VecDf pos;
+		/// Whether the query position lies within the narrow band.
+		bool is_in_band;
+	};
+
 	/**
 	 * Get vector representing a raycast miss.
 	 */
@@ -169,7 +314,13 @@ public:
 		m_grid_status_change(size_, offset(size_), size_partition_, s_outside),
 		// Configure de-dupe grid for neighbourhood queries.
 		m_grid_affected(size_, offset(size_), size_partition_),
-		m_grid_affected_buffer(size_, offset(size_), size_partition_)
+		m_grid_affected_buffer(size_, offset(size_), size_partition_),
+		// Configure empty space skipping hierarchy over spatial partitions.
+		m_pyramid(m_grid_isogrid.children().size()),
+		// Configure tracking of partitions changed since the last checkpoint.
+		m_grid_dirty(m_grid_isogrid.children().size(), m_grid_isogrid.children().offset()),
+		// Default to lossless encoding of sparse snapshots.
+		m_codec(Codec::raw), m_quantum(Impl::Sparse::quantum_default)
 	{}
 
 	/**
@@ -179,6 +330,7 @@ public:
 	 */
 	void save(std::ostream& output_stream_) const
 	{
+		materialise();
 		m_grid_isogrid.write(output_stream_);
 	}
 
@@ -195,167 +347,948 @@ public:
 		return This{std::move(isogrid)};
 	}
 
-
 	/**
-	 * Create a single singularity seed point in the isogrid grid.
+	 * Set the encoding of partition payloads used when saving sparse snapshots and checkpoints.
 	 *
-	 * NOTE: does not handle overwriting of points currently already on the
-	 * surface/in the volume.
+	 * The `compact` codec is typically several times smaller than the (default) `raw` codec, at
+	 * the cost of some CPU and quantisation of narrow band distances to a multiple of `quantum_`.
+	 * Quantised values are kept within their original layer. Loading detects the codec from the
+	 * snapshot, so needs no configuration.
 	 *
-	 * @param pos_centre
+	 * @param codec_ encoding to use.
+	 * @param quantum_ quantisation step of distance values, for the `compact` codec.
 	 */
-	void seed (const VecDi& pos_centre_)
+	void codec(const Codec codec_, const Distance quantum_ = Impl::Sparse::quantum_default)
 	{
-		// Width of seed.
-		const VecDi& vec_width = VecDi::Constant(NodeIdx(s_layer_max));
+		if (!(quantum_ > 0))
+		{
+			std::stringstream sstr;
+			sstr << "Quantisation step must be positive, but got " << quantum_;
+			std::string str = sstr.str();
+			throw std::domain_error(str);
+		}
 
-		// Min and max positions affected by placing seed point.
-		const VecDi& pos_min = pos_centre_ - vec_width;
-		const VecDi& pos_max = pos_centre_ + vec_width;
+		m_codec = codec_;
+		m_quantum = quantum_;
+	}
 
-		// Get vector size of window formed by pos_min and pos_max.
-		const VecDi& pos_window_size = pos_max - pos_min + VecDi::Constant(1); //+1 for zero coord.
+	/**
+	 * Get the encoding of partition payloads used when saving sparse snapshots and checkpoints.
+	 *
+	 * @return encoding.
+	 */
+	Codec codec() const
+	{
+		return m_codec;
+	}
 
-		// Calculate number of grid points to be cycled through within window.
-		const PosIdx pos_idx_max = PosIdx(pos_window_size.prod());
+	/**
+	 * Save only the narrow band of active partitions to given output stream, in a compact binary
+	 * format.
+	 *
+	 * For each active partition, the narrow band points are stored, along with which of the
+	 * remaining points are inside the surface, encoded using the codec set by `codec`. See
+	 * `Impl::Sparse` for the layout.
+	 *
+	 * @param output_stream_ stream to save to.
+	 */
+	void save_sparse(std::ostream& output_stream_) const
+	{
+		materialise();
+		write_sparse(
+			m_grid_isogrid, output_stream_, Impl::Sparse::magic, pos_idxs_stored(m_grid_isogrid),
+			m_codec, m_quantum
+		);
+	}
 
-		// Cycle through each point in window.
-		for (PosIdx pos_idx = 0; pos_idx <= pos_idx_max; pos_idx++)
-		{
-			// Calculate vector position from integer index, using utility function.
-			VecDi pos = Felt::index<D>(pos_idx, pos_window_size);
-			// Translate position into isogrid grid space.
-			pos += pos_min;
-			// Calculate vector distance from this position to seed centre.
-			const VecDi& vec_dist = pos - pos_centre_;
-			// Sum of absolute distance along each axis == city-block distance.
-			const Distance dist = Distance(vec_dist.template lpNorm<1>());
-			const LayerId layer_id_pos = layer_id(dist);
-			// Check distance indicates that this point is within the narrow band.
-			if (inside_band(layer_id_pos))
-			{
-				// Append point to a narrow band layer (if applicable).
-				m_grid_isogrid.track(dist, pos, layer_idx(layer_id_pos));
+	/**
+	 * Save in the sparse format (as `save_sparse`) on a background thread, so that the surface
+	 * can continue to be updated whilst saving.
+	 *
+	 * A full copy of the isogrid is made up front and the background thread reads only the copy,
+	 * so peak memory use is roughly double that of the surface until the save completes. The
+	 * copy is released as soon as it has been written.
+	 *
+	 * The stream must not be accessed until the save completes, see `wait_save`. Any previous
+	 * background save is waited on before starting another.
+	 *
+	 * @param output_stream_ stream to save to.
+	 */
+	void save_async(std::ostream& output_stream_)
+	{
+		wait_save();
+		materialise();
+
+		std::unique_ptr<IsoGrid> pisogrid = std::make_unique<IsoGrid>(
+			m_grid_isogrid.size(), m_grid_isogrid.offset(), m_grid_isogrid.child_size(),
+			Distance(s_outside)
+		);
+		pisogrid->children() = m_grid_isogrid.children();
+
+		// Capture the copy rather than `this`, so the surface can be moved whilst saving.
+		const Codec codec = m_codec;
+		const Distance quantum = m_quantum;
+		m_future_save = std::async(
+			std::launch::async,
+			[pisogrid = std::move(pisogrid), &output_stream_, codec, quantum]() mutable {
+				write_sparse(
+					*pisogrid, output_stream_, Impl::Sparse::magic, pos_idxs_stored(*pisogrid),
+					codec, quantum
+				);
+				pisogrid.reset();
 			}
-		}
+		);
 	}
 
 	/**
-	 * Perform a full update of the narrow band.
+	 * Wait for a background save started by `save_async` to complete.
 	 *
-	 * Lambda function passed will be given the position to process and
-	 * a reference to the isogrid grid, and is expected to return delta isogrid to
-	 * apply.
+	 * Rethrows any exception raised whilst saving.
+	 */
+	void wait_save()
+	{
+		if (m_future_save.valid())
+			m_future_save.get();
+	}
+
+	/**
+	 * Append a delta checkpoint of the spatial partitions changed since the last checkpoint.
 	 *
-	 * Each spatial partition is processed in parallel.
+	 * Partitions are flagged as changed as they are touched by `seed` and updates, i.e. those
+	 * listed by `delta(layer_idx)` and `status_change(layer_idx)`, plus any that the narrow band
+	 * expands into. Only these are written, in the sparse format, after which the changed set is
+	 * cleared.
 	 *
-	 * @param fn_ (pos, isogrid) -> float
+	 * Checkpoints are intended to be appended to a single stream, e.g. a file opened with
+	 * `std::ios::app`, starting with a call to `clean` just after saving the base snapshot with
+	 * `save_sparse`. They can later be applied on top of the base snapshot by the two-stream
+	 * `load_sparse`, or merged into a new base snapshot by `compact`.
+	 *
+	 * @param output_stream_ stream to append to.
 	 */
-	template <typename Fn>
-	void update(Fn&& fn_)
+	void checkpoint(std::ostream& output_stream_)
 	{
-		update_start();
-
-		// We are iterating over the entire zero-layer, so assume the delta grid should track
-		// all active partitions in the main isogrid.
-		m_grid_delta.track_children(m_grid_isogrid);
+		PosIdxList pos_idxs_child = m_grid_dirty.list();
+		std::sort(pos_idxs_child.begin(), pos_idxs_child.end());
+		write_sparse(
+			m_grid_isogrid, output_stream_, Impl::Sparse::magic_delta, pos_idxs_child, m_codec,
+			m_quantum
+		);
+		m_grid_dirty.reset();
+	}
 
-		const PosIdxList& pos_idxs_children = m_grid_isogrid.children().lookup().list(layer_idx(0));
+	/**
+	 * Forget which spatial partitions have changed, e.g. after saving a new base snapshot.
+	 */
+	void clean()
+	{
+		m_grid_dirty.reset();
+	}
 
-		FELT_PARALLEL_FOR(pos_idxs_children.size(),)
-		for (ListIdx list_idx = 0; list_idx < pos_idxs_children.size(); list_idx++)
-		{
-			const PosIdx pos_idx_child = pos_idxs_children[list_idx];
-			typename IsoGrid::Child& isochild = m_grid_isogrid.children().get(pos_idx_child);
+	/**
+	 * Get the spatial partitions changed since the last checkpoint.
+	 *
+	 * @return list of partition position indices, in no particular order.
+	 */
+	const PosIdxList& dirty() const
+	{
+		return m_grid_dirty.list();
+	}
 
-			for (const PosIdx pos_idx_leaf : isochild.lookup().list(layer_idx(0)))
-			{
-				const VecDi& pos_leaf = isochild.index(pos_idx_leaf);
-				const Distance dist_delta = callback(
-					fn_, pos_leaf, const_cast<const IsoGrid&>(m_grid_isogrid)
-				);
+	/**
+	 * Load isogrid saved by `save_sparse` from given input stream and construct surface.
+	 *
+	 * All partition payloads are read in a single pass, then partitions are reconstructed from
+	 * their payloads in parallel, rebuilding each partition's data and narrow band layers
+	 * independently. Finally, partitions are tracked in the isogrid's children lookup.
+	 *
+	 * @param input_stream_ stream to load from.
+	 *
+	 * @return new Surface instance.
+	 */
+	static This load_sparse(std::istream& input_stream_)
+	{
+		using Header = Impl::Sparse::Header<D>;
 
-				#ifdef FELT_DEBUG_ENABLED
-				if (std::abs(dist_delta) > 1.0f)
-				{
-					std::stringstream strs;
-					strs << "Zero layer update value out of bounds: " << Felt::format(pos_leaf)
-						<< " with value " << dist_delta;
-					std::string str = strs.str();
-					throw std::domain_error(str);
-				}
-				#endif
+		Header header;
+		read_sparse(input_stream_, reinterpret_cast<char*>(&header), sizeof(Header));
+		Impl::Sparse::check(header, s_num_layers);
 
-				// Disallow expansion to edge of grid.
-				m_grid_delta.children().get(pos_idx_child).track(
-					dist_delta, pos_idx_leaf, layer_idx(0)
-				);
-			}
+		VecDi size, offset, child_size;
+		for (Dim axis = 0; axis < D; axis++)
+		{
+			size(axis) = header.size[axis];
+			offset(axis) = header.offset[axis];
+			child_size(axis) = header.child_size[axis];
 		}
-		update_end_global();
+		IsoGrid isogrid{size, offset, child_size, header.background};
+		read_sparse_partitions(input_stream_, header, isogrid);
+
+		return This{std::move(isogrid)};
 	}
 
 	/**
-	 * Perform a bounded update of the narrow band.
+	 * Load only the region of a snapshot saved by `save_sparse` that intersects a bounding box,
+	 * and construct a surface covering just that region.
 	 *
-	 * Lambda function passed will be given the position to process and a reference to the isogrid
-	 * grid, and is expected to return delta isogrid to apply.
+	 * The partition table acts as an index, so only the payloads of partitions intersecting the
+	 * box are read, seeking directly to each. The surface's isogrid spans the whole partitions
+	 * intersecting the box, clamped to the bounds of the saved isogrid, so positions are
+	 * unchanged. Partitions not stored take the snapshot's default (outside) background, whilst
+	 * stored inactive partitions (e.g. deep inside the surface) keep their own background.
 	 *
-	 * Each spatial partition is processed in parallel.
+	 * @param input_stream_ seekable stream to load from.
+	 * @param pos_leaf_lower_ lower corner of bounding box (inclusive).
+	 * @param pos_leaf_upper_ upper corner of bounding box (inclusive).
 	 *
-	 * @param pos_leaf_lower_ region selection from.
-	 * @param pos_leaf_upper_ region selection to.
-	 * @param fn_ (pos, isogrid) -> float.
+	 * @return new Surface instance.
 	 */
-	template <typename Fn>
-	void update(const VecDi& pos_leaf_lower_, const VecDi& pos_leaf_upper_, Fn&& fn_)
-	{
-		static const VecDi& one = VecDi::Constant(1);
-		// Upper and lower bounds of the grid, inclusive.
-		const VecDi& pos_grid_lower = m_grid_isogrid.offset();
-		const VecDi& pos_grid_upper =
-			m_grid_isogrid.offset() + m_grid_isogrid.size();
-		// Child partitions containing upper and lower bounds of grid.
-		const VecDi& pos_grid_child_lower = m_grid_isogrid.pos_child(pos_grid_lower);
-		const VecDi& pos_grid_child_upper = m_grid_isogrid.pos_child(pos_grid_upper - one);
-		// Partition containing lower point of bounding box, bounded by grid.
+	static This load_sparse(
+		std::istream& input_stream_, const VecDi& pos_leaf_lower_, const VecDi& pos_leaf_upper_
+	) {
+		using Header = Impl::Sparse::Header<D>;
+		using Entry = Impl::Sparse::Entry;
+
+		const std::istream::pos_type pos_stream = input_stream_.tellg();
+
+		Header header;
+		read_sparse(input_stream_, reinterpret_cast<char*>(&header), sizeof(Header));
+		Impl::Sparse::check(header, s_num_layers);
+
+		VecDi size, offset, child_size;
+		for (Dim axis = 0; axis < D; axis++)
+		{
+			size(axis) = header.size[axis];
+			offset(axis) = header.offset[axis];
+			child_size(axis) = header.child_size[axis];
+		}
+
+		// Partitions intersecting the box, relative to the lower partition of the saved isogrid.
+		const VecDi& pos_leaf_lower = pos_leaf_lower_.cwiseMax(offset);
+		const VecDi& pos_leaf_upper = pos_leaf_upper_.cwiseMin(offset + size - VecDi::Constant(1));
+
+		if ((pos_leaf_lower.array() > pos_leaf_upper.array()).any())
+		{
+			std::stringstream sstr;
+			sstr << "Bounding box " << Felt::format(pos_leaf_lower_) << "-" <<
+				Felt::format(pos_leaf_upper_) << " does not intersect saved isogrid " <<
+				Felt::format(offset) << "-" << Felt::format(VecDi{offset + size});
+			std::string str = sstr.str();
+			throw std::domain_error(str);
+		}
+
 		const VecDi& pos_child_lower =
-			pos_grid_child_lower.cwiseMax(m_grid_isogrid.pos_child(pos_leaf_lower_));
-		// Partition containing upper point of bounding box, bounded by grid.
+			((pos_leaf_lower - offset).array() / child_size.array()).matrix();
 		const VecDi& pos_child_upper =
-			pos_grid_child_upper.cwiseMin(m_grid_isogrid.pos_child(pos_leaf_upper_));
-		// Size of bounding box at partition level.
-		const VecDi& child_bounding_box_size = pos_child_upper - pos_child_lower + one;
-		// Upper bound of leaf (1 more than upper point), bounded by grid..
-		const VecDi& pos_leaf_upper_bound = pos_grid_upper.cwiseMin(pos_leaf_upper_ + one);
-		// Upper index of bounding box.
-		const PosIdx child_idx_bound = PosIdx(child_bounding_box_size.prod());
-		// Clear previous update.
-		update_start();
-		// Parallel loop through spatial partitions.
-		FELT_PARALLEL_FOR(child_idx_bound)
+			((pos_leaf_upper - offset).array() / child_size.array()).matrix();
+		VecDi children_size;
+		for (Dim axis = 0; axis < D; axis++)
+			children_size(axis) = (size(axis) + child_size(axis) - 1) / child_size(axis);
+
+		// Isogrid covering whole partitions intersecting the box.
+		const VecDi& offset_region = offset + pos_child_lower.cwiseProduct(child_size);
+		const VecDi& size_region = (
+			offset + (pos_child_upper + VecDi::Constant(1)).cwiseProduct(child_size)
+		).cwiseMin(offset + size) - offset_region;
+		IsoGrid isogrid{size_region, offset_region, child_size, header.background};
+
+		const std::uint64_t offset_table = Impl::Sparse::align(sizeof(Header));
+		input_stream_.ignore(std::streamsize(offset_table - sizeof(Header)));
+
+		std::vector<Entry> entries(header.num_entries);
+		read_sparse(
+			input_stream_, reinterpret_cast<char*>(entries.data()),
+			entries.size() * sizeof(Entry)
+		);
+
+		// Look up entries of partitions within the box, remapping to partitions of the region.
+		const VecDi& children_size_region = pos_child_upper - pos_child_lower + VecDi::Constant(1);
+		const PosIdx child_idx_bound = PosIdx(children_size_region.prod());
+		std::vector<Entry> entries_region;
 		for (PosIdx child_idx = 0; child_idx < child_idx_bound; child_idx++)
 		{
-			// Get spatial partition position.
-			const VecDi& pos_child_without_offset = Felt::index<D>(
-				child_idx, child_bounding_box_size
+			const VecDi& pos_child_region = Felt::index<D>(child_idx, children_size_region);
+			const std::uint32_t pos_idx_child = std::uint32_t(Felt::index<D>(
+				VecDi{pos_child_region + pos_child_lower}, children_size, VecDi::Zero()
+			));
+
+			const auto it = std::lower_bound(
+				entries.begin(), entries.end(), pos_idx_child,
+				[](const Entry& entry_, const std::uint32_t pos_idx_child_) {
+					return entry_.pos_idx_child < pos_idx_child_;
+				}
 			);
-			const VecDi& pos_child = pos_child_without_offset + pos_child_lower;
-			const PosIdx pos_idx_child = m_grid_isogrid.children().index(pos_child);
-			typename IsoGrid::Child& child = m_grid_isogrid.children().get(pos_idx_child);
+			if (it == entries.end() || it->pos_idx_child != pos_idx_child)
+				continue;
 
-			// Loop all zero-layer points within this partition.
-			for (const PosIdx pos_idx_leaf : child.lookup().list(layer_idx(0)))
-			{
-				const VecDi& pos_leaf = child.index(pos_idx_leaf);
-				// Skip zero-layer points not within finer-grained bounding box.
-				if (Felt::inside(pos_leaf, pos_leaf_lower_, pos_leaf_upper_bound))
-				{
-					const Distance dist_delta = callback(
-						fn_, pos_leaf, const_cast<const IsoGrid&>(m_grid_isogrid)
-					);
+			Entry entry = *it;
+			entry.pos_idx_child = std::uint32_t(isogrid.children().index(
+				VecDi{pos_child_region + isogrid.children().offset()}
+			));
+			entries_region.push_back(entry);
+		}
 
-					#ifdef FELT_DEBUG_ENABLED
+		// Read payloads in file order.
+		std::sort(
+			entries_region.begin(), entries_region.end(),
+			[](const Entry& a_, const Entry& b_) { return a_.offset < b_.offset; }
+		);
+		ListIdx num_bytes = 0;
+		for (const Entry& entry : entries_region)
+			num_bytes += entry.size;
+		std::vector<char> payloads(num_bytes);
+		std::vector<const char*> pbytes(entries_region.size());
+
+		num_bytes = 0;
+		for (ListIdx entry_idx = 0; entry_idx < entries_region.size(); entry_idx++)
+		{
+			const Entry& entry = entries_region[entry_idx];
+			input_stream_.seekg(pos_stream + std::streamoff(entry.offset));
+			read_sparse(input_stream_, payloads.data() + num_bytes, entry.size);
+			pbytes[entry_idx] = payloads.data() + num_bytes;
+			num_bytes += entry.size;
+		}
+
+		decode(isogrid, entries_region, pbytes, header);
+
+		return This{std::move(isogrid)};
+	}
+
+	/**
+	 * Load a base snapshot saved by `save_sparse`, then apply the delta checkpoints appended by
+	 * `checkpoint`, in order, and construct surface.
+	 *
+	 * @param input_stream_ stream to load base snapshot from.
+	 * @param delta_stream_ stream to load delta checkpoints from, read to the end.
+	 *
+	 * @return new Surface instance.
+	 */
+	static This load_sparse(std::istream& input_stream_, std::istream& delta_stream_)
+	{
+		using Header = Impl::Sparse::Header<D>;
+
+		This surface{load_sparse(input_stream_)};
+		IsoGrid& isogrid = surface.m_grid_isogrid;
+
+		while (delta_stream_.peek() != std::istream::traits_type::eof())
+		{
+			Header header;
+			read_sparse(delta_stream_, reinterpret_cast<char*>(&header), sizeof(Header));
+			Impl::Sparse::check(header, s_num_layers, Impl::Sparse::magic_delta);
+
+			for (Dim axis = 0; axis < D; axis++)
+			{
+				if (
+					header.size[axis] != isogrid.size()(axis) ||
+					header.offset[axis] != isogrid.offset()(axis) ||
+					header.child_size[axis] != isogrid.child_size()(axis)
+				) {
+					throw std::domain_error(
+						"Sparse delta checkpoint does not match the grid of the base snapshot"
+					);
+				}
+			}
+
+			read_sparse_partitions(delta_stream_, header, isogrid);
+		}
+
+		for (PosIdx pos_idx_child = 0; pos_idx_child < isogrid.children().data().size();
+			pos_idx_child++
+		)
+			surface.occupy(pos_idx_child);
+
+		return surface;
+	}
+
+	/**
+	 * Merge delta checkpoints into a base snapshot, giving a new base snapshot.
+	 *
+	 * @param input_stream_ stream to load base snapshot from.
+	 * @param delta_stream_ stream to load delta checkpoints from, read to the end.
+	 * @param output_stream_ stream to save merged snapshot to.
+	 */
+	static void compact(
+		std::istream& input_stream_, std::istream& delta_stream_, std::ostream& output_stream_
+	) {
+		load_sparse(input_stream_, delta_stream_).save_sparse(output_stream_);
+	}
+
+	/**
+	 * Memory map a snapshot file saved by `save_sparse` and construct surface, deferring
+	 * reconstruction of partitions until they are first touched.
+	 *
+	 * Only the header and partition table are read up front, so loading is near-instant and the
+	 * payloads of partitions that are never touched are never paged in from disk.
+	 *
+	 * Partitions are materialised on demand by `get`, `seed`, `update`, `delta`, `ray`,
+	 * `nearest`, `closest` and the saving methods, and all at once by `Polys::invalidate`. Until
+	 * then a partition appears inactive to direct isogrid access via `isogrid()`, so call
+	 * `materialise` before accessing the isogrid directly.
+	 *
+	 * The file must not be modified whilst the surface exists.
+	 *
+	 * @param path_ path of snapshot file.
+	 *
+	 * @return new Surface instance.
+	 */
+	static This load_mapped(const std::string& path_)
+	{
+		using Header = Impl::Sparse::Header<D>;
+		using Entry = Impl::Sparse::Entry;
+
+		std::unique_ptr<Lazy> plazy{new Lazy{path_}};
+		const char* data = plazy->mapping.data();
+		const char* data_end = data + plazy->mapping.size();
+
+		Header header;
+		const char* cursor = data;
+		Impl::Sparse::extract(cursor, data_end, &header, 1);
+		Impl::Sparse::check(header, s_num_layers);
+		plazy->codec = header.codec;
+		plazy->quantum = header.quantum;
+
+		VecDi size, offset, child_size;
+		for (Dim axis = 0; axis < D; axis++)
+		{
+			size(axis) = header.size[axis];
+			offset(axis) = header.offset[axis];
+			child_size(axis) = header.child_size[axis];
+		}
+		IsoGrid isogrid{size, offset, child_size, header.background};
+
+		// The table is aligned within the mapping, so can be used in place.
+		cursor = data + Impl::Sparse::align(sizeof(Header));
+		const Entry* entries = reinterpret_cast<const Entry*>(cursor);
+
+		if (
+			cursor > data_end ||
+			ListIdx(data_end - cursor) / sizeof(Entry) < header.num_entries
+		)
+			throw std::domain_error("Sparse snapshot table truncated");
+		for (ListIdx entry_idx = 0; entry_idx < header.num_entries; entry_idx++)
+		{
+			const Entry& entry = entries[entry_idx];
+			check_entry(entry, isogrid);
+			if (entry_idx && entry.pos_idx_child <= entries[entry_idx - 1].pos_idx_child)
+				throw std::domain_error("Sparse snapshot partition table is not sorted");
+			if (
+				entry.offset > plazy->mapping.size() ||
+				entry.size > plazy->mapping.size() - entry.offset
+			)
+				throw std::domain_error("Sparse snapshot payload truncated");
+		}
+
+		const ListIdx num_children = isogrid.children().data().size();
+		plazy->pentries.assign(num_children, nullptr);
+		std::vector<std::atomic<std::uint8_t>>(num_children).swap(plazy->states);
+
+		for (ListIdx entry_idx = 0; entry_idx < header.num_entries; entry_idx++)
+		{
+			const Entry& entry = entries[entry_idx];
+			isogrid.children().get(entry.pos_idx_child).deactivate(entry.background);
+			if (!entry.size)
+				continue;
+			plazy->pentries[entry.pos_idx_child] = &entry;
+			plazy->states[entry.pos_idx_child] = Lazy::pending;
+		}
+
+		This surface{std::move(isogrid)};
+		surface.m_plazy = std::move(plazy);
+
+		// Conservatively assume pending partitions may contain the zero-curve, so queries visit
+		// (and materialise) them rather than skipping them.
+		for (ListIdx entry_idx = 0; entry_idx < header.num_entries; entry_idx++)
+		{
+			const Entry& entry = entries[entry_idx];
+			if (entry.size)
+			{
+				surface.m_pyramid.occupy(
+					surface.m_grid_isogrid.children().index(entry.pos_idx_child) -
+						surface.m_grid_isogrid.children().offset(),
+					true
+				);
+			}
+		}
+
+		return surface;
+	}
+
+	/**
+	 * Check whether a spatial partition has been materialised from a memory mapped snapshot.
+	 *
+	 * @param pos_idx_child_ position index of partition.
+	 * @return true if the partition is in the isogrid, false if pending materialisation.
+	 */
+	bool is_materialised(const PosIdx pos_idx_child_) const
+	{
+		return !m_plazy || m_plazy->states[pos_idx_child_].load() == Lazy::done;
+	}
+
+	/**
+	 * Materialise a spatial partition from a memory mapped snapshot, if pending.
+	 *
+	 * Materialising does not change any value observable through the surface's own methods, so is
+	 * considered logically const. Thread safe.
+	 *
+	 * @param pos_idx_child_ position index of partition.
+	 */
+	void materialise(const PosIdx pos_idx_child_) const
+	{
+		if (is_materialised(pos_idx_child_))
+			return;
+		const_cast<This*>(this)->materialise_child(pos_idx_child_);
+	}
+
+	/**
+	 * Materialise all pending spatial partitions overlapping a region of the isogrid.
+	 *
+	 * @param pos_leaf_lower_ lower corner of region (inclusive).
+	 * @param pos_leaf_upper_ upper corner of region (inclusive).
+	 */
+	void materialise(const VecDi& pos_leaf_lower_, const VecDi& pos_leaf_upper_) const
+	{
+		if (!m_plazy)
+			return;
+
+		const VecDi& pos_grid_lower = m_grid_isogrid.offset();
+		const VecDi& pos_grid_upper =
+			pos_grid_lower + m_grid_isogrid.size() - VecDi::Constant(1);
+		const VecDi& pos_child_lower = m_grid_isogrid.pos_child(
+			pos_leaf_lower_.cwiseMax(pos_grid_lower).cwiseMin(pos_grid_upper)
+		);
+		const VecDi& pos_child_upper = m_grid_isogrid.pos_child(
+			pos_leaf_upper_.cwiseMax(pos_grid_lower).cwiseMin(pos_grid_upper)
+		);
+		const VecDi& child_bounding_box_size = pos_child_upper - pos_child_lower + VecDi::Constant(1);
+		const PosIdx child_idx_bound = PosIdx(child_bounding_box_size.prod());
+
+		for (PosIdx child_idx = 0; child_idx < child_idx_bound; child_idx++)
+		{
+			const VecDi& pos_child =
+				Felt::index<D>(child_idx, child_bounding_box_size) + pos_child_lower;
+			materialise(m_grid_isogrid.children().index(pos_child));
+		}
+	}
+
+	/**
+	 * Materialise all pending spatial partitions, in parallel.
+	 */
+	void materialise() const
+	{
+		if (!m_plazy)
+			return;
+
+		PosIdxList pos_idxs_child;
+		for (PosIdx pos_idx_child = 0; pos_idx_child < m_plazy->states.size(); pos_idx_child++)
+			if (!is_materialised(pos_idx_child))
+				pos_idxs_child.push_back(pos_idx_child);
+
+		materialise(pos_idxs_child);
+	}
+
+	/**
+	 * Materialise a list of spatial partitions, where pending, in parallel.
+	 *
+	 * @param pos_idxs_child_ position indices of partitions.
+	 */
+	void materialise(const PosIdxList& pos_idxs_child_) const
+	{
+		if (!m_plazy)
+			return;
+
+		// Exceptions cannot propagate out of a parallel region, so hold on to the first.
+		std::exception_ptr perror;
+
+		FELT_PARALLEL_FOR(pos_idxs_child_.size(), schedule(dynamic))
+		for (ListIdx list_idx = 0; list_idx < pos_idxs_child_.size(); list_idx++)
+		{
+			try
+			{
+				materialise(pos_idxs_child_[list_idx]);
+			}
+			catch (...)
+			{
+				#pragma omp critical(felt_surface_materialise)
+				if (!perror)
+					perror = std::current_exception();
+			}
+		}
+
+		if (perror)
+			std::rethrow_exception(perror);
+	}
+
+	/**
+	 * Get the value of the isogrid at a position, materialising its partition if pending.
+	 *
+	 * @param pos_ position in isogrid.
+	 * @return distance value stored at position.
+	 */
+	Distance get(const VecDi& pos_) const
+	{
+		if (m_grid_isogrid.inside(pos_))
+			materialise(m_grid_isogrid.pos_idx_child(pos_));
+		return m_grid_isogrid.get(pos_);
+	}
+
+
+	/**
+	 * Create a single singularity seed point in the isogrid grid.
+	 *
+	 * NOTE: does not handle overwriting of points currently already on the
+	 * surface/in the volume. See `stamp` for adding many seeds/shapes to an existing volume.
+	 *
+	 * @param pos_centre
+	 */
+	void seed (const VecDi& pos_centre_)
+	{
+		// Width of seed.
+		const VecDi& vec_width = VecDi::Constant(NodeIdx(s_layer_max));
+
+		// Min and max positions affected by placing seed point.
+		const VecDi& pos_min = pos_centre_ - vec_width;
+		const VecDi& pos_max = pos_centre_ + vec_width;
+
+		materialise(pos_min, pos_max);
+
+		// Get vector size of window formed by pos_min and pos_max.
+		const VecDi& pos_window_size = pos_max - pos_min + VecDi::Constant(1); //+1 for zero coord.
+
+		// Calculate number of grid points to be cycled through within window.
+		const PosIdx pos_idx_max = PosIdx(pos_window_size.prod());
+
+		// Cycle through each point in window.
+		for (PosIdx pos_idx = 0; pos_idx <= pos_idx_max; pos_idx++)
+		{
+			// Calculate vector position from integer index, using utility function.
+			VecDi pos = Felt::index<D>(pos_idx, pos_window_size);
+			// Translate position into isogrid grid space.
+			pos += pos_min;
+			// Calculate vector distance from this position to seed centre.
+			const VecDi& vec_dist = pos - pos_centre_;
+			// Sum of absolute distance along each axis == city-block distance.
+			const Distance dist = Distance(vec_dist.template lpNorm<1>());
+			const LayerId layer_id_pos = layer_id(dist);
+			// Check distance indicates that this point is within the narrow band.
+			if (inside_band(layer_id_pos))
+			{
+				// Append point to a narrow band layer (if applicable).
+				m_grid_isogrid.track(dist, pos, layer_idx(layer_id_pos));
+				occupy(m_grid_isogrid.pos_idx_child(pos));
+				touch(m_grid_isogrid.pos_idx_child(pos));
+			}
+		}
+	}
+
+	/**
+	 * Replace the entire surface with the narrow band of a signed distance function.
+	 *
+	 * Each spatial partition is processed in parallel, so the function is called concurrently
+	 * from multiple threads and must be safe to call concurrently. The function is first
+	 * evaluated at the centre of a partition, and if this shows the zero-curve is too far away
+	 * for any point to lie within the narrow band, then the partition is left inactive, with
+	 * background set to inside or outside as appropriate. Otherwise the function is evaluated at
+	 * every point in the partition and the narrow band layers are built directly.
+	 *
+	 * The function must be a true (or under-estimated) distance, i.e. its value can change by
+	 * at most 1 per unit distance, else partitions touching the narrow band may be skipped.
+	 *
+	 * @param fn_ (pos) -> signed distance, negative inside.
+	 */
+	template <typename Fn>
+	std::enable_if_t<std::is_convertible<std::result_of_t<Fn(const VecDi&)>, Distance>::value>
+	build(Fn&& fn_)
+	{
+		// Any pending partitions would be overwritten.
+		m_plazy.reset();
+
+		auto& children = m_grid_isogrid.children();
+		const ListIdx num_children = children.data().size();
+		const VecDi& size_child = m_grid_isogrid.child_size();
+		const VecDi& pos_centre_offset = size_child / 2;
+		// Distance from centre of a partition to its furthest point.
+		const Distance radius = (
+			pos_centre_offset.cwiseMax(size_child - VecDi::Constant(1) - pos_centre_offset)
+		).template cast<Distance>().norm();
+
+		FELT_PARALLEL_FOR(num_children, schedule(dynamic))
+		for (PosIdx pos_idx_child = 0; pos_idx_child < num_children; pos_idx_child++)
+		{
+			IsoChild& child = children.get(pos_idx_child);
+			const Distance dist_centre = Distance(fn_(VecDi(child.offset() + pos_centre_offset)));
+
+			if (std::abs(dist_centre) - radius > Distance(s_layer_max) + 0.5f)
+			{
+				child.deactivate(dist_centre < 0 ? Distance(s_inside) : Distance(s_outside));
+				continue;
+			}
+
+			rebuild(child, [&fn_, &child](const PosIdx pos_idx_leaf_) {
+				return Distance(fn_(child.index(pos_idx_leaf_)));
+			});
+		}
+
+		for (PosIdx pos_idx_child = 0; pos_idx_child < num_children; pos_idx_child++)
+			retrack(pos_idx_child);
+	}
+
+	/**
+	 * Replace the entire surface with the narrow band of a dense signed distance volume.
+	 *
+	 * Positions outside the volume are considered outside the surface.
+	 *
+	 * @param volume_ grid of signed distance values, negative inside.
+	 */
+	void build(const Impl::Grid::Snapshot<Distance, D>& volume_)
+	{
+		build([&volume_](const VecDi& pos_) {
+			const VecDi& pos_max = volume_.offset() + volume_.size();
+			return Felt::inside(pos_, volume_.offset(), pos_max) ?
+				volume_.get(pos_) : Distance(s_outside);
+		});
+	}
+
+	/**
+	 * Stamp a batch of primitive shapes into the surface, as a union with the existing volume.
+	 *
+	 * Unlike `seed`, overlapping existing volume is handled. Only spatial partitions within reach
+	 * of a primitive are modified, each processed in parallel, with the narrow band layers of
+	 * each partition rebuilt once all primitives overlapping it have been applied.
+	 *
+	 * @param primitives_ shapes to add to the volume.
+	 */
+	void stamp(const std::vector<Primitive>& primitives_)
+	{
+		auto& children = m_grid_isogrid.children();
+		const VecDi& pos_grid_lower = m_grid_isogrid.offset();
+		const VecDi& pos_grid_upper = pos_grid_lower + m_grid_isogrid.size() - VecDi::Constant(1);
+		// Points further than this from every primitive are unchanged.
+		const Distance reach = Distance(s_outside);
+
+		// Primitives overlapping each partition, listing only those partitions with any.
+		std::vector<std::vector<ListIdx>> primitive_idxs_child(children.data().size());
+		PosIdxList pos_idxs_child;
+
+		for (ListIdx primitive_idx = 0; primitive_idx < primitives_.size(); primitive_idx++)
+		{
+			const VecDi& pos_leaf_lower = primitives_[primitive_idx].lower(reach);
+			const VecDi& pos_leaf_upper = primitives_[primitive_idx].upper(reach);
+
+			if (
+				(pos_leaf_upper.array() < pos_grid_lower.array()).any() ||
+				(pos_leaf_lower.array() > pos_grid_upper.array()).any()
+			)
+				continue;
+
+			const VecDi& pos_child_lower = m_grid_isogrid.pos_child(
+				pos_leaf_lower.cwiseMax(pos_grid_lower)
+			);
+			const VecDi& pos_child_upper = m_grid_isogrid.pos_child(
+				pos_leaf_upper.cwiseMin(pos_grid_upper)
+			);
+			const VecDi& child_bounding_box_size =
+				pos_child_upper - pos_child_lower + VecDi::Constant(1);
+			const PosIdx child_idx_bound = PosIdx(child_bounding_box_size.prod());
+
+			for (PosIdx child_idx = 0; child_idx < child_idx_bound; child_idx++)
+			{
+				const VecDi& pos_child =
+					Felt::index<D>(child_idx, child_bounding_box_size) + pos_child_lower;
+				const PosIdx pos_idx_child = children.index(pos_child);
+				if (primitive_idxs_child[pos_idx_child].empty())
+					pos_idxs_child.push_back(pos_idx_child);
+				primitive_idxs_child[pos_idx_child].push_back(primitive_idx);
+			}
+		}
+
+		materialise(pos_idxs_child);
+
+		FELT_PARALLEL_FOR(pos_idxs_child.size(), schedule(dynamic))
+		for (ListIdx list_idx = 0; list_idx < pos_idxs_child.size(); list_idx++)
+		{
+			const PosIdx pos_idx_child = pos_idxs_child[list_idx];
+			IsoChild& child = children.get(pos_idx_child);
+			const bool is_active = child.is_active();
+			const Distance background = child.background();
+			const std::vector<ListIdx>& primitive_idxs = primitive_idxs_child[pos_idx_child];
+
+			rebuild(
+				child,
+				[&](const PosIdx pos_idx_leaf_) {
+					const VecDi& pos = child.index(pos_idx_leaf_);
+					Distance dist = is_active ? child.get(pos_idx_leaf_) : background;
+					for (const ListIdx primitive_idx : primitive_idxs)
+						dist = std::min(dist, primitives_[primitive_idx].distance(pos));
+					return dist;
+				}
+			);
+		}
+
+		for (const PosIdx pos_idx_child : pos_idxs_child)
+			retrack(pos_idx_child);
+	}
+
+	/**
+	 * Replace the surface with the union of itself and another surface.
+	 *
+	 * @param other_ surface with the same size, offset and partition size.
+	 */
+	void unite(const This& other_)
+	{
+		combine(other_, [](const Distance dist_, const Distance dist_other_) {
+			return std::min(dist_, dist_other_);
+		});
+	}
+
+	/**
+	 * Replace the surface with the intersection of itself and another surface.
+	 *
+	 * @param other_ surface with the same size, offset and partition size.
+	 */
+	void intersect(const This& other_)
+	{
+		combine(other_, [](const Distance dist_, const Distance dist_other_) {
+			return std::max(dist_, dist_other_);
+		});
+	}
+
+	/**
+	 * Replace the surface with the difference of itself and another surface, i.e. cut the other
+	 * surface's volume away.
+	 *
+	 * @param other_ surface with the same size, offset and partition size.
+	 */
+	void subtract(const This& other_)
+	{
+		combine(other_, [](const Distance dist_, const Distance dist_other_) {
+			return std::max(dist_, -dist_other_);
+		});
+	}
+
+	/**
+	 * Perform a full update of the narrow band.
+	 *
+	 * Lambda function passed will be given the position to process and
+	 * a reference to the isogrid grid, and is expected to return delta isogrid to
+	 * apply.
+	 *
+	 * Each spatial partition is processed in parallel.
+	 *
+	 * @param fn_ (pos, isogrid) -> float
+	 */
+	template <typename Fn>
+	void update(Fn&& fn_)
+	{
+		// Every partition may be touched.
+		materialise();
+
+		update_start();
+
+		// We are iterating over the entire zero-layer, so assume the delta grid should track
+		// all active partitions in the main isogrid.
+		m_grid_delta.track_children(m_grid_isogrid);
+
+		const PosIdxList& pos_idxs_children = m_grid_isogrid.children().lookup().list(layer_idx(0));
+
+		FELT_PARALLEL_FOR(pos_idxs_children.size(),)
+		for (ListIdx list_idx = 0; list_idx < pos_idxs_children.size(); list_idx++)
+		{
+			const PosIdx pos_idx_child = pos_idxs_children[list_idx];
+			typename IsoGrid::Child& isochild = m_grid_isogrid.children().get(pos_idx_child);
+
+			for (const PosIdx pos_idx_leaf : isochild.lookup().list(layer_idx(0)))
+			{
+				const VecDi& pos_leaf = isochild.index(pos_idx_leaf);
+				const Distance dist_delta = callback(
+					fn_, pos_leaf, const_cast<const IsoGrid&>(m_grid_isogrid)
+				);
+
+				#ifdef FELT_DEBUG_ENABLED
+				if (std::abs(dist_delta) > 1.0f)
+				{
+					std::stringstream strs;
+					strs << "Zero layer update value out of bounds: " << Felt::format(pos_leaf)
+						<< " with value " << dist_delta;
+					std::string str = strs.str();
+					throw std::domain_error(str);
+				}
+				#endif
+
+				// Disallow expansion to edge of grid.
+				m_grid_delta.children().get(pos_idx_child).track(
+					dist_delta, pos_idx_leaf, layer_idx(0)
+				);
+			}
+		}
+		update_end_global();
+	}
+
+	/**
+	 * Perform a bounded update of the narrow band.
+	 *
+	 * Lambda function passed will be given the position to process and a reference to the isogrid
+	 * grid, and is expected to return delta isogrid to apply.
+	 *
+	 * Each spatial partition is processed in parallel.
+	 *
+	 * @param pos_leaf_lower_ region selection from.
+	 * @param pos_leaf_upper_ region selection to.
+	 * @param fn_ (pos, isogrid) -> float.
+	 */
+	template <typename Fn>
+	void update(const VecDi& pos_leaf_lower_, const VecDi& pos_leaf_upper_, Fn&& fn_)
+	{
+		static const VecDi& one = VecDi::Constant(1);
+		// Upper and lower bounds of the grid, inclusive.
+		const VecDi& pos_grid_lower = m_grid_isogrid.offset();
+		const VecDi& pos_grid_upper =
+			m_grid_isogrid.offset() + m_grid_isogrid.size();
+		// Child partitions containing upper and lower bounds of grid.
+		const VecDi& pos_grid_child_lower = m_grid_isogrid.pos_child(pos_grid_lower);
+		const VecDi& pos_grid_child_upper = m_grid_isogrid.pos_child(pos_grid_upper - one);
+		// Partition containing lower point of bounding box, bounded by grid.
+		const VecDi& pos_child_lower =
+			pos_grid_child_lower.cwiseMax(m_grid_isogrid.pos_child(pos_leaf_lower_));
+		// Partition containing upper point of bounding box, bounded by grid.
+		const VecDi& pos_child_upper =
+			pos_grid_child_upper.cwiseMin(m_grid_isogrid.pos_child(pos_leaf_upper_));
+		// Size of bounding box at partition level.
+		const VecDi& child_bounding_box_size = pos_child_upper - pos_child_lower + one;
+		// Upper bound of leaf (1 more than upper point), bounded by grid..
+		const VecDi& pos_leaf_upper_bound = pos_grid_upper.cwiseMin(pos_leaf_upper_ + one);
+		// Upper index of bounding box.
+		const PosIdx child_idx_bound = PosIdx(child_bounding_box_size.prod());
+		// Ensure partitions that may be touched by the update are in the isogrid.
+		materialise(
+			pos_leaf_lower_ - VecDi::Constant(s_update_reach),
+			pos_leaf_upper_ + VecDi::Constant(s_update_reach)
+		);
+		// Clear previous update.
+		update_start();
+		// Parallel loop through spatial partitions.
+		FELT_PARALLEL_FOR(child_idx_bound)
+		for (PosIdx child_idx = 0; child_idx < child_idx_bound; child_idx++)
+		{
+			// Get spatial partition position.
+			const VecDi& pos_child_without_offset = Felt::index<D>(
+				child_idx, child_bounding_box_size
+			);
+			const VecDi& pos_child = pos_child_without_offset + pos_child_lower;
+			const PosIdx pos_idx_child = m_grid_isogrid.children().index(pos_child);
+			typename IsoGrid::Child& child = m_grid_isogrid.children().get(pos_idx_child);
+
+			// Loop all zero-layer points within this partition.
+			for (const PosIdx pos_idx_leaf : child.lookup().list(layer_idx(0)))
+			{
+				const VecDi& pos_leaf = child.index(pos_idx_leaf);
+				// Skip zero-layer points not within finer-grained bounding box.
+				if (Felt::inside(pos_leaf, pos_leaf_lower_, pos_leaf_upper_bound))
+				{
+					const Distance dist_delta = callback(
+						fn_, pos_leaf, const_cast<const IsoGrid&>(m_grid_isogrid)
+					);
+
+					#ifdef FELT_DEBUG_ENABLED
 
 					if (m_grid_delta.children().get(pos_idx_child).get(pos_idx_leaf) != 0)
 					{
@@ -374,335 +1307,1157 @@ public:
 						throw std::domain_error(str);
 					}
 
-					#endif
+					#endif
+
+					// Update delta isogrid.
+					m_grid_delta.track(dist_delta, pos_idx_child, pos_idx_leaf, layer_idx(0));
+				}
+			}
+		}
+		// Apply delta to isogrid.
+		update_end();
+	}
+
+	/**
+	 * Reset delta isogrid to zero and clear update lists.
+	 *
+	 * @snippet test_Surface.cpp Simple delta isogrid update
+	 */
+	void update_start ()
+	{
+		m_grid_delta.reset(m_grid_isogrid);
+		m_grid_affected.reset(m_grid_isogrid);
+		m_grid_affected_buffer.reset(m_grid_isogrid);
+		m_grid_status_change.reset(m_grid_isogrid);
+	}
+
+	/**
+	 * Update zero layer then update distance transform for affected points in each layer.
+	 */
+	void update_end ()
+	{
+		// Get points in outer layers that are affected by changes in zero-layer.
+		calc_affected();
+
+		m_grid_isogrid.track_children(m_grid_affected);
+		m_grid_delta.track_children(m_grid_affected);
+
+		// Update the zero layer, applying delta to isogrid.
+		update_zero_layer(&m_grid_affected_buffer);
+		AffectedLookupGrid* plookup = &m_grid_affected;
+		AffectedLookupGrid* plookup_buffer = &m_grid_affected_buffer;
+		bool is_status_changed = update_distance(plookup, plookup_buffer);
+		flush_status_change();
+		expand_narrow_band();
+
+		while (is_status_changed)
+		{
+			plookup->reset(m_grid_isogrid);
+			std::swap(plookup, plookup_buffer);
+			m_grid_status_change.reset(m_grid_affected);
+			is_status_changed = update_distance(plookup, plookup_buffer);
+			flush_status_change();
+			expand_narrow_band();
+		}
+
+	}
+
+
+	/**
+	 * Update delta isogrid grid, tracking to tracking list if not already tracked.
+	 *
+	 * @snippet test_Surface.cpp Simple delta isogrid update
+	 *
+	 * @param pos position to update.
+	 * @param val value to set at given position.
+	 */
+	void delta (const VecDi& pos_, Distance val_)
+	{
+		#if defined(FELT_EXCEPTIONS) || !defined(NDEBUG)
+
+		const LayerId layer_id_new = layer_id(val_);
+		if (layer_id_new != 0 && layer_id_new != 1 && layer_id_new != -1)
+		{
+			std::stringstream strs;
+			strs << "Delta update value out of bounds. Attempted to update position " <<
+				Felt::format(pos_) << " by " << val_ << " would give a layer of "
+				<< layer_id_new << ", which is too much of a jump";
+			std::string str = strs.str();
+			throw std::domain_error(str);
+		}
+
+		#endif
+
+		// Ensure partitions that may be touched by the update are in the isogrid.
+		materialise(
+			pos_ - VecDi::Constant(s_update_reach), pos_ + VecDi::Constant(s_update_reach)
+		);
+
+		m_grid_delta.track(val_, pos_, layer_idx(0));
+	}
+
+	/**
+	 * Cast a ray to the zero layer.
+	 *
+	 * The ray is first clipped to the bounds of the isogrid, then spatial partitions are visited
+	 * in order front to back along the ray using a 3D-DDA (Amanatides-Woo) traversal of the
+	 * children grid. Blocks of partitions that cannot contain the zero-curve are skipped in one go
+	 * using the occupancy hierarchy, and traversal stops at the first hit.
+	 *
+	 * @param pos_origin_ originating point of ray
+	 * @param dir_ normal vector in direction of ray
+	 * @param march_ method to use to march the ray through the narrow band of a partition.
+	 * @return zero curve hit location or NULL_POS.
+	 */
+	VecDf ray(
+		const VecDf& pos_origin_, const VecDf& dir_, const RayMarch march_ = RayMarch::sphere
+	) const {
+		// Ray to test against.
+		const Line line(pos_origin_, dir_);
+
+		// Bounds of isogrid grid.
+		const VecDf& pos_grid_lower = m_grid_isogrid.offset().template cast<Distance>();
+		const VecDf& pos_grid_upper =
+			pos_grid_lower + m_grid_isogrid.size().template cast<Distance>();
+
+		// Clip ray to isogrid grid bounds, giving the range of ray parameter `t` within the grid.
+		Distance t_enter = 0;
+		Distance t_exit = std::numeric_limits<Distance>::max();
+		for (Dim dim = 0; dim < D; dim++)
+		{
+			if (dir_(dim) == 0)
+			{
+				if (pos_origin_(dim) < pos_grid_lower(dim) || pos_origin_(dim) >= pos_grid_upper(dim))
+					return ray_miss;
+				continue;
+			}
+			Distance t_lower = (pos_grid_lower(dim) - pos_origin_(dim)) / dir_(dim);
+			Distance t_upper = (pos_grid_upper(dim) - pos_origin_(dim)) / dir_(dim);
+			if (t_lower > t_upper)
+				std::swap(t_lower, t_upper);
+			t_enter = std::max(t_enter, t_lower);
+			t_exit = std::min(t_exit, t_upper);
+		}
+		if (t_enter > t_exit)
+			return ray_miss;
+
+		// Size of spatial partitions, in leaf grid space.
+		const VecDi& child_size = m_grid_isogrid.child_size();
+		// Number of spatial partitions along each axis.
+		const VecDi& children_size = m_grid_isogrid.children().size();
+		// Position of partition containing entry point, relative to lower corner of children grid.
+		VecDi pos_child;
+		// Direction to step through children grid along each axis.
+		VecDi step;
+		// Ray parameter `t` at which the next partition boundary is crossed along each axis.
+		VecDf t_next;
+		// Increment in ray parameter `t` to cross an entire partition along each axis.
+		VecDf t_delta;
+
+		// Get position of partition containing given point along an axis, bounded to a range to
+		// guard against floating point error at boundaries.
+		const auto pos_child_at = [&](
+			const Dim dim_, const VecDf& pos_, const NodeIdx lower_, const NodeIdx upper_
+		) -> NodeIdx {
+			const NodeIdx pos_child_dim = NodeIdx(std::floor(
+				(pos_(dim_) - pos_grid_lower(dim_)) / Distance(child_size(dim_))
+			));
+			return std::max(lower_, std::min(upper_, pos_child_dim));
+		};
+		// Get ray parameter `t` at which the ray crosses the lower boundary of a partition.
+		const auto t_at = [&](const Dim dim_, const NodeIdx pos_child_dim_) -> Distance {
+			const Distance pos_boundary =
+				pos_grid_lower(dim_) + Distance(pos_child_dim_ * child_size(dim_));
+			return (pos_boundary - pos_origin_(dim_)) / dir_(dim_);
+		};
+		// Get ray parameter `t` at which the ray exits the current partition along an axis.
+		const auto t_next_at = [&](const Dim dim_) -> Distance {
+			if (step(dim_) == 0)
+				return std::numeric_limits<Distance>::max();
+			return t_at(dim_, pos_child(dim_) + (step(dim_) > 0 ? 1 : 0));
+		};
+
+		const VecDf& pos_enter = line.pointAt(t_enter);
+		for (Dim dim = 0; dim < D; dim++)
+		{
+			pos_child(dim) = pos_child_at(dim, pos_enter, 0, children_size(dim) - 1);
+			step(dim) = sgn(dir_(dim));
+			t_next(dim) = t_next_at(dim);
+			t_delta(dim) = step(dim) == 0 ?
+				std::numeric_limits<Distance>::max() :
+				Distance(child_size(dim)) / std::abs(dir_(dim));
+		}
+
+		Distance t_child = t_enter;
+
+		// Walk the children grid front to back, testing partitions that may contain the zero-curve.
+		while (true)
+		{
+			// Coarsest level of the occupancy pyramid at which the block containing this partition
+			// is empty of the zero-curve, if any.
+			const ListIdx level_empty = m_pyramid.empty_level(pos_child);
+
+			if (level_empty == null_idx)
+			{
+				// Partition may contain the zero-curve, so march through it, ensuring it and the
+				// neighbours sampled when interpolating are in the isogrid.
+				const VecDi& pos_leaf_lower =
+					m_grid_isogrid.offset() + pos_child.cwiseProduct(child_size);
+				materialise(
+					pos_leaf_lower - VecDi::Constant(1),
+					pos_leaf_lower + child_size
+				);
+
+				Dim dim_next;
+				const Distance t_child_exit = std::min(t_next.minCoeff(&dim_next), t_exit);
+
+				const VecDf& pos_hit = ray(line, t_child, t_child_exit, march_);
+				if (pos_hit != ray_miss)
+					return pos_hit;
+
+				if (t_next(dim_next) > t_exit)
+					break;
+
+				t_child = t_next(dim_next);
+				t_next(dim_next) += t_delta(dim_next);
+				pos_child(dim_next) += step(dim_next);
+			}
+			else
+			{
+				// Block of partitions is empty, so skip straight to where the ray exits it.
+				const NodeIdx block_size = NodeIdx(1) << level_empty;
+				const VecDi& pos_block_lower =
+					Occupancy::block(pos_child, level_empty) * block_size;
+
+				Dim dim_next = 0;
+				Distance t_block_exit = std::numeric_limits<Distance>::max();
+				for (Dim dim = 0; dim < D; dim++)
+				{
+					if (step(dim) == 0)
+						continue;
+					const Distance t_block_exit_dim = t_at(
+						dim, pos_block_lower(dim) + (step(dim) > 0 ? block_size : 0)
+					);
+					if (t_block_exit_dim < t_block_exit)
+					{
+						t_block_exit = t_block_exit_dim;
+						dim_next = dim;
+					}
+				}
+
+				if (t_block_exit > t_exit)
+					break;
+
+				t_child = t_block_exit;
+				const VecDf& pos_block_exit = line.pointAt(t_child);
+
+				// Partition the ray enters on exiting the block.
+				for (Dim dim = 0; dim < D; dim++)
+				{
+					if (dim == dim_next)
+					{
+						pos_child(dim) = step(dim) > 0 ?
+							pos_block_lower(dim) + block_size : pos_block_lower(dim) - 1;
+					}
+					else
+					{
+						pos_child(dim) = pos_child_at(
+							dim, pos_block_exit, pos_block_lower(dim),
+							std::min(pos_block_lower(dim) + block_size, children_size(dim)) - 1
+						);
+					}
+				}
+
+				for (Dim dim = 0; dim < D; dim++)
+					t_next(dim) = t_next_at(dim);
+			}
+
+			// Stop if ray has left the children grid.
+			if (!Felt::inside(pos_child, VecDi{VecDi::Zero()}, children_size))
+				break;
+		}
+
+		return ray_miss;
+	}
+
+	/**
+	 * Find the nearest zero-layer point within a given radius.
+	 *
+	 * Uses the occupancy hierarchy over spatial partitions to skip blocks that are either empty
+	 * or further away than the best candidate found so far.
+	 *
+	 * @param pos_ position to search from.
+	 * @param radius_ maximum distance to search.
+	 * @return position of nearest zero-layer grid point, or ray_miss if none within radius.
+	 */
+	VecDf nearest(const VecDf& pos_, const Distance radius_) const
+	{
+		Distance dist_sq_nearest = radius_ * radius_;
+		VecDf pos_nearest = ray_miss;
+		nearest(
+			pos_, VecDi{VecDi::Zero()}, m_pyramid.num_levels() - 1, dist_sq_nearest, pos_nearest
+		);
+		return pos_nearest;
+	}
+
+	/**
+	 * Query signed distance, normal and closest point on the zero-curve for many positions.
+	 *
+	 * Queries are grouped by spatial partition and each partition is processed in parallel.
+	 * Positions within inactive partitions (or outside the isogrid) are cheaply reported as beyond
+	 * the narrow band, with the distance set to the background value of the partition.
+	 *
+	 * @param positions_ positions to query.
+	 * @return query result for each position, in the same order as the input.
+	 */
+	std::vector<Closest> closest(const std::vector<VecDf>& positions_) const
+	{
+		const ListIdx num_queries = positions_.size();
+		std::vector<Closest> results(num_queries);
 
-					// Update delta isogrid.
-					m_grid_delta.track(dist_delta, pos_idx_child, pos_idx_leaf, layer_idx(0));
+		// Spatial partition containing each query position, or null_idx if outside the isogrid.
+		PosIdxList pos_idxs_child(num_queries);
+		for (ListIdx query_idx = 0; query_idx < num_queries; query_idx++)
+		{
+			const VecDf& pos = positions_[query_idx];
+			const VecDi& pos_floor = pos.array().floor().matrix().template cast<NodeIdx>();
+			pos_idxs_child[query_idx] = m_grid_isogrid.inside(pos) ?
+				m_grid_isogrid.pos_idx_child(pos_floor) : null_idx;
+			// Ensure partitions sampled by interpolation are in the isogrid.
+			if (pos_idxs_child[query_idx] != null_idx)
+				materialise(pos_floor - VecDi::Constant(1), pos_floor + VecDi::Constant(2));
+		}
+
+		// Query indices sorted by spatial partition, so queries can be processed in groups.
+		std::vector<ListIdx> query_idxs(num_queries);
+		for (ListIdx query_idx = 0; query_idx < num_queries; query_idx++)
+			query_idxs[query_idx] = query_idx;
+		std::sort(
+			query_idxs.begin(), query_idxs.end(),
+			[&pos_idxs_child](const ListIdx a, const ListIdx b) {
+				return pos_idxs_child[a] < pos_idxs_child[b];
+			}
+		);
+
+		// Index of first query in each spatial partition group, plus end of final group.
+		std::vector<ListIdx> group_starts;
+		for (ListIdx list_idx = 0; list_idx < num_queries; list_idx++)
+		{
+			if (
+				list_idx == 0 ||
+				pos_idxs_child[query_idxs[list_idx]] != pos_idxs_child[query_idxs[list_idx - 1]]
+			)
+				group_starts.push_back(list_idx);
+		}
+		group_starts.push_back(num_queries);
+		const ListIdx num_groups = group_starts.size() - 1;
+
+		FELT_PARALLEL_FOR(num_groups,)
+		for (ListIdx group_idx = 0; group_idx < num_groups; group_idx++)
+		{
+			const ListIdx list_idx_begin = group_starts[group_idx];
+			const ListIdx list_idx_end = group_starts[group_idx + 1];
+			const PosIdx pos_idx_child = pos_idxs_child[query_idxs[list_idx_begin]];
+
+			// Beyond the narrow band if outside the grid or within an inactive partition.
+			Distance background = Distance(s_outside);
+			bool is_active = false;
+			if (pos_idx_child != null_idx)
+			{
+				const typename IsoGrid::Child& child = m_grid_isogrid.children().get(pos_idx_child);
+				background = child.background();
+				is_active = child.is_active();
+			}
+
+			for (ListIdx list_idx = list_idx_begin; list_idx < list_idx_end; list_idx++)
+			{
+				const ListIdx query_idx = query_idxs[list_idx];
+				Closest& result = results[query_idx];
+
+				if (!is_active)
+				{
+					result = Closest{background, VecDf::Zero(), ray_miss, false};
+					continue;
 				}
+
+				const VecDf& pos = positions_[query_idx];
+				const Distance dist = m_grid_isogrid.interp(pos);
+				VecDf normal = m_grid_isogrid.grad(pos);
+				const Distance norm = normal.norm();
+				if (norm > TINY)
+					normal /= norm;
+				else
+					normal.setZero();
+
+				result = Closest{
+					dist, normal, VecDf{pos - normal * dist}, inside_band(layer_id(dist))
+				};
 			}
 		}
-		// Apply delta to isogrid.
-		update_end();
+
+		return results;
 	}
 
 	/**
-	 * Reset delta isogrid to zero and clear update lists.
+	 * Gather statistics about the current state of the surface.
 	 *
-	 * @snippet test_Surface.cpp Simple delta isogrid update
+	 * @return statistics object with values for the number of active spatial partitions.
 	 */
-	void update_start ()
+	Stats stats() const
 	{
-		m_grid_delta.reset(m_grid_isogrid);
-		m_grid_affected.reset(m_grid_isogrid);
-		m_grid_affected_buffer.reset(m_grid_isogrid);
-		m_grid_status_change.reset(m_grid_isogrid);
+		return Stats{
+			num_active_partitions(m_grid_isogrid),
+			num_active_partitions(m_grid_delta)
+		};
 	}
 
 	/**
-	 * Update zero layer then update distance transform for affected points in each layer.
+	 * Get list of spatial partitions where iso values were updated in last update.
+	 *
+	 * @param layer_idx_ index of layer list to get.
+	 * @return list of position indices.
 	 */
-	void update_end ()
+	const PosIdxList& delta(const TupleIdx layer_idx_) const
 	{
-		// Get points in outer layers that are affected by changes in zero-layer.
-		calc_affected();
+		return m_grid_delta.children().lookup().list(layer_idx_);
+	}
 
-		m_grid_isogrid.track_children(m_grid_affected);
-		m_grid_delta.track_children(m_grid_affected);
+	/**
+	 * Get list of points within a spatial partition where iso values were updated in last update.
+	 *
+	 * @param pos_idx_child_ position index of spatial partition.
+	 * @param layer_idx_ index of layer list to get.
+	 * @return list of position indices of points within the partition.
+	 */
+	const PosIdxList& delta(const PosIdx pos_idx_child_, const TupleIdx layer_idx_) const
+	{
+		return m_grid_delta.children().get(pos_idx_child_).list(layer_idx_);
+	}
 
-		// Update the zero layer, applying delta to isogrid.
-		update_zero_layer(&m_grid_affected_buffer);
-		AffectedLookupGrid* plookup = &m_grid_affected;
-		AffectedLookupGrid* plookup_buffer = &m_grid_affected_buffer;
-		bool is_status_changed = update_distance(plookup, plookup_buffer);
-		flush_status_change();
-		expand_narrow_band();
+	/**
+	 * Get list of spatial partitions where layer status change occurred in last update.
+	 *
+	 * @param layer_idx_ index of layer list to get.
+	 * @return list of position indices.
+	 */
+	const PosIdxList& status_change(const TupleIdx layer_idx_) const
+	{
+		return m_grid_status_change.children().lookup().list(layer_idx_);
+	}
 
-		while (is_status_changed)
+	/**
+	 * Get reference to isogrid grid.
+	 *
+	 * @return signed distance isogrid embedding the level set surface.
+	 */
+	const IsoGrid& isogrid () const
+	{
+		return m_grid_isogrid;
+	}
+
+	/**
+	 * Get narrow band layer index of ID for indexing into arrays.
+	 *
+	 * Internally we can of course not have negative array indices, so must convert to an
+	 * index first.
+	 *
+	 * @param id narrow band layer ID.
+	 * @return index to use to get given layer in narrow band array.
+	 */
+	static constexpr TupleIdx layer_idx(const LayerId id_)
+	{
+		return TupleIdx(id_ + LayerId(s_num_layers) / 2);
+	}
+
+	/**
+	 * Check if child spatial partition contains zero-layer points.
+	 *
+	 * @param pos_idx_child position index of child partition.
+	 * @return true if zero-curve cuts through partition, false otherwise.
+	 */
+	bool is_intersected(const PosIdx pos_idx_child)
+	{
+		return bool(m_grid_isogrid.children().get(pos_idx_child).list(layer_idx(0)).size());
+	}
+
+	/**
+	 * Get points affected by most recent update, in the form of a lookup grid.
+	 *
+	 * @return the affected lookup grid.
+	 */
+	const AffectedLookupGrid& affected() const
+	{
+		return m_grid_affected;
+	}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Begin private
+private:
+
+	/**
+	 * Explicitly deleted default constructor.
+	 */
+	Surface () = delete;
+
+	/**
+	 * Encode the narrow band of an isogrid partition as a sparse snapshot payload.
+	 *
+	 * @param child partition to encode.
+	 * @param bytes_ buffer to populate, left empty if the partition is inactive.
+	 * @param codec_ encoding to use.
+	 * @param quantum_ quantisation step of distance values, if applicable to the codec.
+	 */
+	static void encode(
+		const IsoChild& child, std::vector<char>& bytes_, const Codec codec_,
+		const Distance quantum_
+	) {
+		bytes_.clear();
+
+		if (!child.is_active())
+			return;
+
+		if (codec_ == Codec::compact)
 		{
-			plookup->reset(m_grid_isogrid);
-			std::swap(plookup, plookup_buffer);
-			m_grid_status_change.reset(m_grid_affected);
-			is_status_changed = update_distance(plookup, plookup_buffer);
-			flush_status_change();
-			expand_narrow_band();
+			encode_compact(child, bytes_, quantum_);
+			return;
+		}
+
+		std::uint32_t num_leafs[s_num_layers];
+		for (TupleIdx layer_idx = 0; layer_idx < s_num_layers; layer_idx++)
+			num_leafs[layer_idx] = std::uint32_t(child.lookup().list(layer_idx).size());
+		Impl::Sparse::append(bytes_, num_leafs, s_num_layers);
+
+		std::vector<Impl::Sparse::Leaf> leafs;
+		for (TupleIdx layer_idx = 0; layer_idx < s_num_layers; layer_idx++)
+			for (const PosIdx pos_idx_leaf : child.lookup().list(layer_idx))
+				leafs.push_back(
+					Impl::Sparse::Leaf{std::uint32_t(pos_idx_leaf), child.get(pos_idx_leaf)}
+				);
+		Impl::Sparse::append(bytes_, leafs.data(), leafs.size());
+
+		// Flag points inside the surface, so values beyond the narrow band can be restored.
+		std::vector<std::uint8_t> mask((child.data().size() + 7) / 8, 0);
+		for (PosIdx pos_idx_leaf = 0; pos_idx_leaf < child.data().size(); pos_idx_leaf++)
+			if (child.get(pos_idx_leaf) < 0)
+				mask[pos_idx_leaf / 8] |= std::uint8_t(1 << (pos_idx_leaf % 8));
+		Impl::Sparse::append(bytes_, mask.data(), mask.size());
+	}
+
+	/**
+	 * Encode an active isogrid partition using the `compact` codec.
+	 *
+	 * @param child partition to encode.
+	 * @param bytes_ buffer to append to.
+	 * @param quantum_ quantisation step of distance values.
+	 */
+	static void encode_compact(
+		const IsoChild& child, std::vector<char>& bytes_, const Distance quantum_
+	) {
+		// Class of each point, for run-length encoding.
+		std::vector<std::uint8_t> classes(child.data().size());
+		for (PosIdx pos_idx_leaf = 0; pos_idx_leaf < child.data().size(); pos_idx_leaf++)
+			classes[pos_idx_leaf] = child.get(pos_idx_leaf) < 0 ? s_class_inside : s_class_outside;
+		for (TupleIdx layer_idx = 0; layer_idx < s_num_layers; layer_idx++)
+			for (const PosIdx pos_idx_leaf : child.lookup().list(layer_idx))
+				classes[pos_idx_leaf] = s_class_band;
+
+		PosIdx pos_idx_run = 0;
+		for (PosIdx pos_idx_leaf = 1; pos_idx_leaf <= classes.size(); pos_idx_leaf++)
+		{
+			if (pos_idx_leaf < classes.size() && classes[pos_idx_leaf] == classes[pos_idx_run])
+				continue;
+			Impl::Sparse::append_varint(
+				bytes_, (std::uint64_t(pos_idx_leaf - pos_idx_run) << 2) | classes[pos_idx_run]
+			);
+			pos_idx_run = pos_idx_leaf;
+		}
+
+		LayerId layer_id_prev = 0;
+		std::int64_t frac_prev = 0;
+		for (PosIdx pos_idx_leaf = 0; pos_idx_leaf < classes.size(); pos_idx_leaf++)
+		{
+			if (classes[pos_idx_leaf] != s_class_band)
+				continue;
+
+			const Distance dist = child.get(pos_idx_leaf);
+			const LayerId layer_id_leaf = layer_id(dist);
+			std::int64_t quant = std::llround(dist / quantum_);
+			// Nudge the quantised value back into the layer of the original value, if required.
+			while (layer_id(Distance(quant) * quantum_) > layer_id_leaf)
+				quant--;
+			while (layer_id(Distance(quant) * quantum_) < layer_id_leaf)
+				quant++;
+			// Offset of quantised value from the layer's integer value.
+			const std::int64_t frac = quant - std::llround(Distance(layer_id_leaf) / quantum_);
+
+			Impl::Sparse::append_varint(
+				bytes_,
+				Impl::Sparse::zigzag(frac - frac_prev) * s_layer_deltas +
+					Impl::Sparse::zigzag(layer_id_leaf - layer_id_prev)
+			);
+			layer_id_prev = layer_id_leaf;
+			frac_prev = frac;
+		}
+	}
+
+	/**
+	 * Restore an isogrid partition from a sparse snapshot payload.
+	 *
+	 * Only the partition itself is modified, so partitions can be restored in parallel. The
+	 * caller is responsible for tracking the partition in the isogrid's children lookup.
+	 *
+	 * @param child_ partition to restore.
+	 * @param entry_ partition table entry.
+	 * @param bytes_ start of payload.
+	 * @param end_ end of payload.
+	 * @param codec_ encoding of payload.
+	 * @param quantum_ quantisation step of distance values, if applicable to the codec.
+	 */
+	static void decode(
+		IsoChild& child_, const Impl::Sparse::Entry& entry_, const char* bytes_, const char* end_,
+		const Codec codec_, const Distance quantum_
+	) {
+		child_.deactivate(entry_.background);
+
+		if (!entry_.size)
+			return;
+
+		child_.activate();
+
+		if (codec_ == Codec::compact)
+		{
+			decode_compact(child_, bytes_, end_, quantum_);
+			return;
+		}
+
+		std::uint32_t num_leafs[s_num_layers];
+		Impl::Sparse::extract(bytes_, end_, num_leafs, s_num_layers);
+
+		ListIdx num_leafs_total = 0;
+		for (TupleIdx layer_idx = 0; layer_idx < s_num_layers; layer_idx++)
+			num_leafs_total += num_leafs[layer_idx];
+		std::vector<Impl::Sparse::Leaf> leafs(num_leafs_total);
+		Impl::Sparse::extract(bytes_, end_, leafs.data(), leafs.size());
+
+		std::vector<std::uint8_t> mask((child_.data().size() + 7) / 8);
+		Impl::Sparse::extract(bytes_, end_, mask.data(), mask.size());
+
+		for (PosIdx pos_idx_leaf = 0; pos_idx_leaf < child_.data().size(); pos_idx_leaf++)
+			child_.set(
+				pos_idx_leaf,
+				(mask[pos_idx_leaf / 8] >> (pos_idx_leaf % 8)) & 1 ?
+					Distance(s_inside) : Distance(s_outside)
+			);
+
+		ListIdx leaf_idx = 0;
+		for (TupleIdx layer_idx = 0; layer_idx < s_num_layers; layer_idx++)
+		{
+			for (std::uint32_t list_idx = 0; list_idx < num_leafs[layer_idx]; list_idx++)
+			{
+				const Impl::Sparse::Leaf& leaf = leafs[leaf_idx++];
+				if (leaf.pos_idx >= child_.data().size())
+					throw std::domain_error("Sparse snapshot point is outside its partition");
+				child_.track(leaf.value, leaf.pos_idx, layer_idx);
+			}
+		}
+	}
+
+	/**
+	 * Restore an active isogrid partition from a payload encoded with the `compact` codec.
+	 *
+	 * @param child_ partition to restore.
+	 * @param bytes_ start of payload.
+	 * @param end_ end of payload.
+	 * @param quantum_ quantisation step of distance values.
+	 */
+	static void decode_compact(
+		IsoChild& child_, const char* bytes_, const char* end_, const Distance quantum_
+	) {
+		PosIdxList pos_idxs_band;
+
+		for (PosIdx pos_idx_leaf = 0; pos_idx_leaf < child_.data().size();)
+		{
+			const std::uint64_t run = Impl::Sparse::extract_varint(bytes_, end_);
+			const std::uint8_t cls = std::uint8_t(run & 3);
+			const PosIdx pos_idx_end = std::min(
+				PosIdx(child_.data().size()), pos_idx_leaf + PosIdx(run >> 2)
+			);
+
+			for (; pos_idx_leaf < pos_idx_end; pos_idx_leaf++)
+			{
+				if (cls == s_class_band)
+					pos_idxs_band.push_back(pos_idx_leaf);
+				else
+					child_.set(
+						pos_idx_leaf,
+						cls == s_class_inside ? Distance(s_inside) : Distance(s_outside)
+					);
+			}
+		}
+
+		LayerId layer_id_leaf = 0;
+		std::int64_t frac = 0;
+		for (const PosIdx pos_idx_leaf : pos_idxs_band)
+		{
+			const std::uint64_t val = Impl::Sparse::extract_varint(bytes_, end_);
+			layer_id_leaf += LayerId(Impl::Sparse::unzigzag(val % s_layer_deltas));
+			frac += Impl::Sparse::unzigzag(val / s_layer_deltas);
+			if (layer_id_leaf < s_layer_min || layer_id_leaf > s_layer_max)
+				throw std::domain_error("Sparse snapshot point is outside the narrow band");
+			const std::int64_t quant = std::llround(Distance(layer_id_leaf) / quantum_) + frac;
+			child_.track(Distance(quant) * quantum_, pos_idx_leaf, layer_idx(layer_id_leaf));
+		}
+	}
+
+	/**
+	 * Materialise a pending spatial partition from the memory mapped snapshot.
+	 *
+	 * If another thread is already materialising the partition, waits for it to finish.
+	 *
+	 * @param pos_idx_child_ position index of partition.
+	 */
+	void materialise_child(const PosIdx pos_idx_child_)
+	{
+		std::atomic<std::uint8_t>& state = m_plazy->states[pos_idx_child_];
+
+		// Claim the partition, or wait for another thread to finish with it. If the other thread
+		// fails, the partition reverts to pending and is claimed (and fails) here instead.
+		for (;;)
+		{
+			std::uint8_t state_expected = Lazy::pending;
+			if (state.compare_exchange_strong(state_expected, Lazy::busy))
+				break;
+			if (state_expected == Lazy::done)
+				return;
+			std::this_thread::yield();
+		}
+
+		const Impl::Sparse::Entry& entry = *m_plazy->pentries[pos_idx_child_];
+		const char* payload = m_plazy->mapping.data() + entry.offset;
+		IsoChild& child = m_grid_isogrid.children().get(pos_idx_child_);
+		try
+		{
+			decode(
+				child, entry, payload, payload + entry.size, m_plazy->codec, m_plazy->quantum
+			);
+		}
+		catch (...)
+		{
+			child.deactivate(entry.background);
+			state.store(Lazy::pending);
+			throw;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_plazy->mutex);
+			for (TupleIdx layer_idx = 0; layer_idx < s_num_layers; layer_idx++)
+				if (child.lookup().list(layer_idx).size())
+					m_grid_isogrid.children().lookup().track(pos_idx_child_, layer_idx);
+		}
+
+		state.store(Lazy::done);
+	}
+
+	/**
+	 * Rebuild the narrow band of a spatial partition from new distance values.
+	 *
+	 * Values beyond the narrow band are clamped to inside or outside, and if no values lie within
+	 * the narrow band then the partition is deactivated. Only touches the partition itself, so is
+	 * safe to call for different partitions in parallel. The partition must be tracked in the
+	 * partition lookup afterward using `retrack`.
+	 *
+	 * @param child_ partition to rebuild.
+	 * @param fn_ (pos_idx_leaf) -> distance value of leaf.
+	 */
+	template <typename Fn>
+	void rebuild(IsoChild& child_, Fn&& fn_)
+	{
+		// Gather values before modifying the partition, since they may depend on its old values.
+		std::vector<Distance> dists(PosIdx(child_.size().prod()));
+		for (PosIdx pos_idx_leaf = 0; pos_idx_leaf < dists.size(); pos_idx_leaf++)
+			dists[pos_idx_leaf] = fn_(pos_idx_leaf);
+
+		child_.deactivate(Distance(s_outside));
+		child_.activate();
+
+		bool is_band = false;
+		bool is_inside = false;
+
+		for (PosIdx pos_idx_leaf = 0; pos_idx_leaf < dists.size(); pos_idx_leaf++)
+		{
+			const Distance dist = dists[pos_idx_leaf];
+			const LayerId layer_id_leaf = layer_id(dist);
+
+			if (inside_band(layer_id_leaf))
+			{
+				child_.track(dist, pos_idx_leaf, layer_idx(layer_id_leaf));
+				is_band = true;
+			}
+			else
+			{
+				is_inside = dist < 0;
+				child_.set(pos_idx_leaf, is_inside ? Distance(s_inside) : Distance(s_outside));
+			}
 		}
 
+		// No narrow band points, so every point is on the same side of the zero-curve.
+		if (!is_band)
+			child_.deactivate(is_inside ? Distance(s_inside) : Distance(s_outside));
 	}
 
-
 	/**
-	 * Update delta isogrid grid, tracking to tracking list if not already tracked.
+	 * Track a rebuilt spatial partition in the layers it has points in, and only those layers.
 	 *
-	 * @snippet test_Surface.cpp Simple delta isogrid update
+	 * Also updates the empty space skipping hierarchy and flags the partition as changed.
 	 *
-	 * @param pos position to update.
-	 * @param val value to set at given position.
+	 * @param pos_idx_child_ position index of partition.
 	 */
-	void delta (const VecDi& pos_, Distance val_)
+	void retrack(const PosIdx pos_idx_child_)
 	{
-		#if defined(FELT_EXCEPTIONS) || !defined(NDEBUG)
+		auto& children = m_grid_isogrid.children();
+		const IsoChild& child = children.get(pos_idx_child_);
 
-		const LayerId layer_id_new = layer_id(val_);
-		if (layer_id_new != 0 && layer_id_new != 1 && layer_id_new != -1)
+		for (TupleIdx layer_idx = 0; layer_idx < s_num_layers; layer_idx++)
 		{
-			std::stringstream strs;
-			strs << "Delta update value out of bounds. Attempted to update position " <<
-				Felt::format(pos_) << " by " << val_ << " would give a layer of "
-				<< layer_id_new << ", which is too much of a jump";
-			std::string str = strs.str();
-			throw std::domain_error(str);
+			if (child.is_active() && child.lookup().list(layer_idx).size())
+				children.lookup().track(pos_idx_child_, layer_idx);
+			else
+				children.lookup().untrack(pos_idx_child_, layer_idx);
 		}
-
-		#endif
-
-		m_grid_delta.track(val_, pos_, layer_idx(0));
+		occupy(pos_idx_child_);
+		touch(pos_idx_child_);
 	}
 
 	/**
-	 * Cast a ray to the zero layer.
+	 * Combine the isogrid with that of another surface, point by point.
 	 *
-	 * @param pos_origin_ originating point of ray
-	 * @param dir_ normal vector in direction of ray
-	 * @return zero curve hit location or NULL_POS.
+	 * Each spatial partition is processed in parallel. Where both operands' partitions are
+	 * inactive, only the background value is combined, otherwise the narrow band of the partition
+	 * is rebuilt from the combined values.
+	 *
+	 * @param other_ surface with the same size, offset and partition size.
+	 * @param fn_ (distance, other distance) -> combined distance.
 	 */
-	VecDf ray(const VecDf& pos_origin_, const VecDf& dir_) const
+	template <typename Fn>
+	void combine(const This& other_, Fn&& fn_)
 	{
-
-		using ChildHits = std::vector<ChildHit>;
-
-		// If ray is cast from within isogrid grid, first check child grid containing origin point.
-		if (m_grid_isogrid.inside(pos_origin_))
-		{
-			const VecDf& pos_hit = ray(
-				pos_origin_, dir_,
-				m_grid_isogrid.children().get(
-					m_grid_isogrid.pos_child(pos_origin_.template cast<NodeIdx>())
-				)
-			);
-			if (pos_hit != ray_miss)
-				return pos_hit;
+		if (
+			other_.m_grid_isogrid.size() != m_grid_isogrid.size() ||
+			other_.m_grid_isogrid.offset() != m_grid_isogrid.offset() ||
+			other_.m_grid_isogrid.child_size() != m_grid_isogrid.child_size()
+		) {
+			std::stringstream sstr;
+			sstr << "Cannot combine surfaces with different layouts: size " <<
+				Felt::format(m_grid_isogrid.size()) << " vs. " <<
+				Felt::format(other_.m_grid_isogrid.size()) << ", offset " <<
+				Felt::format(m_grid_isogrid.offset()) << " vs. " <<
+				Felt::format(other_.m_grid_isogrid.offset()) << ", partition size " <<
+				Felt::format(m_grid_isogrid.child_size()) << " vs. " <<
+				Felt::format(other_.m_grid_isogrid.child_size());
+			std::string str = sstr.str();
+			throw std::domain_error(str);
 		}
 
-		// Ray to test against.
-		Line line(pos_origin_, dir_);
+		auto& children = m_grid_isogrid.children();
+		const auto& children_other = other_.m_grid_isogrid.children();
+		const ListIdx num_children = children.data().size();
+		// Flag partitions that have changed, so must be re-tracked.
+		std::vector<std::uint8_t> is_changed(num_children, 0);
 
-		// Tracking list for child grids that are hit.
-		ChildHits child_hits;
+		materialise();
+		other_.materialise();
 
-		// Cycle each axis, casting ray to child grid planes marching away from origin.
-		for (Dim dim = 0; dim < dir_.size(); dim++)
+		FELT_PARALLEL_FOR(num_children, schedule(dynamic))
+		for (PosIdx pos_idx_child = 0; pos_idx_child < num_children; pos_idx_child++)
 		{
-			// Direction +/-1 along this axis.
-			Distance dir_dim = Distance(sgn(dir_(dim)));
-			if (dir_dim == 0)
-				continue;
-
-			// Get next child plane along this axis.
-			Distance pos_plane_dim = round_to_next(
-				dim, dir_dim, pos_origin_(dim), m_grid_isogrid.child_size()
-			);
-
-			// Construct vector with elements not on this axis at zero.
-			VecDf pos_plane = VecDf::Constant(0);
-			pos_plane(dim) = pos_plane_dim;
+			IsoChild& child = children.get(pos_idx_child);
+			const IsoChild& child_other = children_other.get(pos_idx_child);
+			const bool is_active = child.is_active();
+			const bool is_active_other = child_other.is_active();
 
-			// If the zero point on this plane is not within the grid, then jump to max/min point
-			// on isogrid grid.
-			if (!m_grid_isogrid.inside(pos_plane))
+			if (!is_active && !is_active_other)
 			{
-				Distance pos_grid_dim;
-				// If casting in -'ve direction, get maximum extent.
-				if (dir_dim == -1)
+				const Distance background = fn_(child.background(), child_other.background());
+				if (background != child.background())
 				{
-					pos_grid_dim = Distance(
-						m_grid_isogrid.offset()(dim) + m_grid_isogrid.size()(dim)
-					);
-					if (pos_plane_dim < pos_grid_dim)
-						continue;
-				}
-				// Else if casting in +'ve direction, get minimum extent.
-				else
-				{
-					pos_grid_dim = Distance(m_grid_isogrid.offset()(dim));
-					if (pos_plane_dim > pos_grid_dim)
-						continue;
-				}
-				// Reset plane position to max/min extent as calculated above.
-				pos_plane(dim) = pos_grid_dim;
-			}
-
-			// Plane normal is opposite to ray direction.
-			VecDf normal = VecDf::Constant(0);
-			normal(dim) = -dir_dim;
-
-			// Cast ray to plane and track any child grids hit on the way to tracking list.
-			// If child size is not a factor of grid size then this first cast could be to outside
-			// the grid.  So cannot quit early here and must try next child.
-			ray_check_track_child(child_hits, line, Plane(normal, pos_plane(dim) * dir_dim));
-
-			// Round up/down to next child, in case we started at inexact modulo of child grid size
-			// (i.e. when isogrid grid size is not integer multiple of child grid size).
-			pos_plane_dim = round_to_next(
-				dim, dir_dim, pos_plane(dim), m_grid_isogrid.child_size()
-			);
-			// If rounding produced a different plane, then cast to that plane, and potentially track
-			// child grid to tracking list.
-			if (pos_plane_dim != pos_plane(dim))
-			{
-				pos_plane(dim) = pos_plane_dim;
-				if (!ray_check_track_child(child_hits, line, Plane(normal, pos_plane(dim) * dir_dim)))
-					continue;
-			}
-
-			// Keep marching along planes, casting ray to each and tracking any candidate child
-			// grids to the tracking list.
-			const Distance child_size_dim = Distance(m_grid_isogrid.child_size()(dim));
-			while (true)
-			{
-				pos_plane(dim) += dir_dim * child_size_dim;
-				if (
-					!ray_check_track_child(
-						child_hits, line, Plane(normal, pos_plane(dim) * dir_dim)
-					)
-				) {
-					break;
+					child.deactivate(background);
+					is_changed[pos_idx_child] = 1;
 				}
+				continue;
 			}
-		}
-
-		// untrack children whose raycast hit point lies outside themselves.  Possible if a child
-		// has been allowed to be tracked in order for the loop above to continue on to the next
-		// child, via dir vs. offset/size check in ray_check_track_child().
-//		child_hits.erase(std::untrack_if(
-//			child_hits.begin(), child_hits.end(),
-//			[this](const ChildHit& child_hit) {
-//				return !this->m_grid_isogrid.children()
-//					.get(child_hit.pos_child)
-//					.inside(child_hit.pos_intersect);
-//			}
-//		), child_hits.end());
-
-		// Sort candidate child grids in distance order from front to back.
-		std::sort(
-			child_hits.begin(), child_hits.end(),
-			[&pos_origin_](const ChildHit& a, const ChildHit& b) -> bool {
-				const VecDf& dist_a = (a.pos_intersect - pos_origin_);
-				const VecDf& dist_b = (b.pos_intersect - pos_origin_);
-				return dist_a.squaredNorm() < dist_b.squaredNorm();
-			}
-		);
-		// untrack any duplicate child grids from the sorted list (i.e. where ray intersects
-		// precisely at the interesction of two or more planes).
-		child_hits.erase(std::unique(
-			child_hits.begin(), child_hits.end(),
-			[](const ChildHit& a, const ChildHit& b) -> bool {
-				return a.pos_idx_child == b.pos_idx_child;
-			}
-		), child_hits.end());
 
-		// For each candidate child, cast ray through until the zero-curve is hit.
-		for (const ChildHit& child_hit : child_hits)
-		{
-			const VecDf& pos_hit = ray(
-				child_hit.pos_intersect, dir_,
-				m_grid_isogrid.children().get(child_hit.pos_idx_child)
-			);
+			const Distance background = child.background();
+			const Distance background_other = child_other.background();
 
-			if (pos_hit != ray_miss)
-				return pos_hit;
+			rebuild(child, [&](const PosIdx pos_idx_leaf_) {
+				return Distance(fn_(
+					is_active ? child.get(pos_idx_leaf_) : background,
+					is_active_other ? child_other.get(pos_idx_leaf_) : background_other
+				));
+			});
+			is_changed[pos_idx_child] = 1;
 		}
 
-		return ray_miss;
+		for (PosIdx pos_idx_child = 0; pos_idx_child < num_children; pos_idx_child++)
+			if (is_changed[pos_idx_child])
+				retrack(pos_idx_child);
 	}
 
 	/**
-	 * Gather statistics about the current state of the surface.
+	 * Flag a spatial partition as changed, for the next checkpoint.
 	 *
-	 * @return statistics object with values for the number of active spatial partitions.
+	 * @param pos_idx_child_ position index of partition.
 	 */
-	Stats stats() const
+	void touch(const PosIdx pos_idx_child_)
 	{
-		return Stats{
-			num_active_partitions(m_grid_isogrid),
-			num_active_partitions(m_grid_delta)
-		};
+		m_grid_dirty.track(pos_idx_child_);
 	}
 
 	/**
-	 * Get list of spatial partitions where iso values were updated in last update.
+	 * Get the partitions of an isogrid to store in a snapshot, i.e. those that are active or
+	 * have a non-default background.
 	 *
-	 * @param layer_idx_ index of layer list to get.
-	 * @return list of position indices.
+	 * @param isogrid_ isogrid to query.
+	 * @return position indices of partitions, in ascending order.
 	 */
-	const PosIdxList& delta(const TupleIdx layer_idx_) const
+	static PosIdxList pos_idxs_stored(const IsoGrid& isogrid_)
 	{
-		return m_grid_delta.children().lookup().list(layer_idx_);
+		const auto& children = isogrid_.children();
+
+		PosIdxList pos_idxs_child;
+		for (PosIdx pos_idx_child = 0; pos_idx_child < children.data().size(); pos_idx_child++)
+		{
+			const IsoChild& child = children.get(pos_idx_child);
+			if (child.is_active() || child.background() != Distance(s_outside))
+				pos_idxs_child.push_back(pos_idx_child);
+		}
+		return pos_idxs_child;
 	}
 
 	/**
-	 * Get list of spatial partitions where layer status change occurred in last update.
+	 * Write given partitions of an isogrid in the sparse format.
 	 *
-	 * @param layer_idx_ index of layer list to get.
-	 * @return list of position indices.
+	 * @param isogrid_ isogrid to write.
+	 * @param output_stream_ stream to write to.
+	 * @param magic_ identifier to write to the header, i.e. snapshot or delta checkpoint.
+	 * @param pos_idxs_child_ position indices of partitions to write, in ascending order.
+	 * @param codec_ encoding of partition payloads.
+	 * @param quantum_ quantisation step of distance values, if applicable to the codec.
 	 */
-	const PosIdxList& status_change(const TupleIdx layer_idx_) const
-	{
-		return m_grid_status_change.children().lookup().list(layer_idx_);
+	static void write_sparse(
+		const IsoGrid& isogrid_, std::ostream& output_stream_, const char* magic_,
+		const PosIdxList& pos_idxs_child_, const Codec codec_, const Distance quantum_
+	) {
+		using Header = Impl::Sparse::Header<D>;
+		using Entry = Impl::Sparse::Entry;
+
+		const auto& children = isogrid_.children();
+
+		std::vector<Entry> entries;
+		for (const PosIdx pos_idx_child : pos_idxs_child_)
+		{
+			entries.push_back(Entry{
+				std::uint32_t(pos_idx_child), children.get(pos_idx_child).background(), 0, 0
+			});
+		}
+
+		std::vector<std::vector<char>> payloads(entries.size());
+
+		FELT_PARALLEL_FOR(entries.size())
+		for (ListIdx entry_idx = 0; entry_idx < entries.size(); entry_idx++)
+			encode(
+				children.get(entries[entry_idx].pos_idx_child), payloads[entry_idx], codec_,
+				quantum_
+			);
+
+		Header header;
+		std::memcpy(header.magic, magic_, sizeof(header.magic));
+		header.version = Impl::Sparse::version;
+		header.dims = D;
+		header.num_lists = s_num_layers;
+		header.num_entries = std::uint32_t(entries.size());
+		for (Dim axis = 0; axis < D; axis++)
+		{
+			header.size[axis] = isogrid_.size()(axis);
+			header.offset[axis] = isogrid_.offset()(axis);
+			header.child_size[axis] = isogrid_.child_size()(axis);
+		}
+		header.background = Distance(s_outside);
+		header.codec = codec_;
+		header.quantum = quantum_;
+
+		// Locate payloads after the table.
+		const std::uint64_t offset_table = Impl::Sparse::align(sizeof(Header));
+		std::uint64_t offset = offset_table + entries.size() * sizeof(Entry);
+		for (ListIdx entry_idx = 0; entry_idx < entries.size(); entry_idx++)
+		{
+			offset = Impl::Sparse::align(offset);
+			entries[entry_idx].offset = offset;
+			entries[entry_idx].size = payloads[entry_idx].size();
+			offset += payloads[entry_idx].size();
+		}
+
+		// Zeros for padding up to alignment boundaries.
+		const char padding[Impl::Sparse::alignment] = {};
+
+		output_stream_.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+		output_stream_.write(padding, std::streamsize(offset_table - sizeof(Header)));
+		output_stream_.write(
+			reinterpret_cast<const char*>(entries.data()),
+			std::streamsize(entries.size() * sizeof(Entry))
+		);
+		offset = offset_table + entries.size() * sizeof(Entry);
+		for (ListIdx entry_idx = 0; entry_idx < entries.size(); entry_idx++)
+		{
+			output_stream_.write(padding, std::streamsize(entries[entry_idx].offset - offset));
+			output_stream_.write(
+				payloads[entry_idx].data(), std::streamsize(payloads[entry_idx].size())
+			);
+			offset = entries[entry_idx].offset + entries[entry_idx].size;
+		}
+		// Pad to a boundary, so that a subsequently appended checkpoint is also aligned.
+		output_stream_.write(padding, std::streamsize(Impl::Sparse::align(offset) - offset));
+
+		output_stream_.flush();
 	}
 
 	/**
-	 * Get reference to isogrid grid.
+	 * Read the partition table and payloads following a sparse header, and restore the listed
+	 * partitions of an isogrid.
 	 *
-	 * @return signed distance isogrid embedding the level set surface.
+	 * Partitions are restored from their payloads in parallel, then (re)tracked in the isogrid's
+	 * children lookup.
+	 *
+	 * @param input_stream_ stream to read from, positioned just after the header.
+	 * @param header_ header already read from the stream.
+	 * @param isogrid_ isogrid to restore partitions of.
 	 */
-	const IsoGrid& isogrid () const
-	{
-		return m_grid_isogrid;
+	static void read_sparse_partitions(
+		std::istream& input_stream_, const Impl::Sparse::Header<D>& header_, IsoGrid& isogrid_
+	) {
+		using Header = Impl::Sparse::Header<D>;
+		using Entry = Impl::Sparse::Entry;
+
+		const std::uint64_t offset_table = Impl::Sparse::align(sizeof(Header));
+		input_stream_.ignore(std::streamsize(offset_table - sizeof(Header)));
+
+		std::vector<Entry> entries(header_.num_entries);
+		read_sparse(
+			input_stream_, reinterpret_cast<char*>(entries.data()),
+			entries.size() * sizeof(Entry)
+		);
+
+		// Read all payloads at once.
+		const std::uint64_t offset_payloads = offset_table + entries.size() * sizeof(Entry);
+		std::uint64_t offset_end = offset_payloads;
+		for (ListIdx entry_idx = 0; entry_idx < entries.size(); entry_idx++)
+		{
+			const Entry& entry = entries[entry_idx];
+			check_entry(entry, isogrid_);
+			if (entry_idx && entry.pos_idx_child <= entries[entry_idx - 1].pos_idx_child)
+				throw std::domain_error("Sparse snapshot partition table is not sorted");
+			if (entry.size && entry.offset < offset_payloads)
+				throw std::domain_error("Sparse snapshot payload overlaps partition table");
+			offset_end = std::max(offset_end, entry.offset + entry.size);
+		}
+		std::vector<char> payloads(offset_end - offset_payloads);
+		read_sparse(input_stream_, payloads.data(), payloads.size());
+		input_stream_.ignore(std::streamsize(Impl::Sparse::align(offset_end) - offset_end));
+
+		std::vector<const char*> pbytes(entries.size());
+		for (ListIdx entry_idx = 0; entry_idx < entries.size(); entry_idx++)
+			pbytes[entry_idx] = payloads.data() + (entries[entry_idx].offset - offset_payloads);
+
+		decode(isogrid_, entries, pbytes, header_);
 	}
 
 	/**
-	 * Get narrow band layer index of ID for indexing into arrays.
+	 * Check that a partition table entry read from a sparse snapshot refers to a partition of
+	 * an isogrid.
 	 *
-	 * Internally we can of course not have negative array indices, so must convert to an
-	 * index first.
-	 *
-	 * @param id narrow band layer ID.
-	 * @return index to use to get given layer in narrow band array.
+	 * @param entry_ partition table entry.
+	 * @param isogrid_ isogrid being restored.
 	 */
-	static constexpr TupleIdx layer_idx(const LayerId id_)
+	static void check_entry(const Impl::Sparse::Entry& entry_, const IsoGrid& isogrid_)
 	{
-		return TupleIdx(id_ + LayerId(s_num_layers) / 2);
+		if (entry_.pos_idx_child >= isogrid_.children().data().size())
+		{
+			std::stringstream sstr;
+			sstr << "Sparse snapshot partition " << entry_.pos_idx_child <<
+				" is outside the grid of " << isogrid_.children().data().size() << " partitions";
+			std::string str = sstr.str();
+			throw std::domain_error(str);
+		}
 	}
 
 	/**
-	 * Check if child spatial partition contains zero-layer points.
+	 * Restore partitions of an isogrid from their sparse snapshot payloads.
 	 *
-	 * @param pos_idx_child position index of child partition.
-	 * @return true if zero-curve cuts through partition, false otherwise.
+	 * Partitions are restored in parallel, then (re)tracked in the isogrid's children lookup.
+	 *
+	 * @param isogrid_ isogrid to restore partitions of.
+	 * @param entries_ partition table entries, giving the position index of each partition
+	 * 	within the given isogrid.
+	 * @param pbytes_ start of payload of each entry.
+	 * @param header_ header of snapshot, giving the encoding of payloads.
 	 */
-	bool is_intersected(const PosIdx pos_idx_child)
-	{
-		return bool(m_grid_isogrid.children().get(pos_idx_child).list(layer_idx(0)).size());
+	static void decode(
+		IsoGrid& isogrid_, const std::vector<Impl::Sparse::Entry>& entries_,
+		const std::vector<const char*>& pbytes_, const Impl::Sparse::Header<D>& header_
+	) {
+		// Exceptions cannot propagate out of a parallel region, so hold on to the first.
+		std::exception_ptr perror;
+
+		FELT_PARALLEL_FOR(entries_.size(), schedule(dynamic))
+		for (ListIdx entry_idx = 0; entry_idx < entries_.size(); entry_idx++)
+		{
+			const Impl::Sparse::Entry& entry = entries_[entry_idx];
+			try
+			{
+				decode(
+					isogrid_.children().get(entry.pos_idx_child), entry, pbytes_[entry_idx],
+					pbytes_[entry_idx] + entry.size, header_.codec, header_.quantum
+				);
+			}
+			catch (...)
+			{
+				#pragma omp critical(felt_surface_decode)
+				if (!perror)
+					perror = std::current_exception();
+			}
+		}
+
+		if (perror)
+			std::rethrow_exception(perror);
+
+		// Track partitions in the layers they have points in, and only those layers.
+		for (const Impl::Sparse::Entry& entry : entries_)
+		{
+			const IsoChild& child = isogrid_.children().get(entry.pos_idx_child);
+			for (TupleIdx layer_idx = 0; layer_idx < s_num_layers; layer_idx++)
+			{
+				if (child.is_active() && child.lookup().list(layer_idx).size())
+					isogrid_.children().lookup().track(entry.pos_idx_child, layer_idx);
+				else
+					isogrid_.children().lookup().untrack(entry.pos_idx_child, layer_idx);
+			}
+		}
 	}
 
 	/**
-	 * Get points affected by most recent update, in the form of a lookup grid.
+	 * Read bytes from a sparse snapshot stream.
 	 *
-	 * @return the affected lookup grid.
+	 * @param input_stream_ stream to read from.
+	 * @param bytes_ buffer to populate.
+	 * @param num_bytes_ number of bytes to read.
 	 */
-	const AffectedLookupGrid& affected() const
+	static void read_sparse(std::istream& input_stream_, char* bytes_, const ListIdx num_bytes_)
 	{
-		return m_grid_affected;
-	}
+		input_stream_.read(bytes_, std::streamsize(num_bytes_));
 
-///////////////////////////////////////////////////////////////////////////////////////////////////
-// Begin private
-private:
-
-	/**
-	 * Explicitly deleted default constructor.
-	 */
-	Surface () = delete;
+		if (!input_stream_)
+			throw std::domain_error("Sparse snapshot stream truncated");
+	}
 
 	/**
 	 * Construct surface from isogrid.
@@ -726,8 +2481,19 @@ private:
 		},
 		m_grid_affected_buffer{
 			m_grid_isogrid.size(), m_grid_isogrid.offset(), m_grid_isogrid.child_size()
-		}
-	{}
+		},
+		// Configure empty space skipping hierarchy over spatial partitions.
+		m_pyramid{m_grid_isogrid.children().size()},
+		// Configure tracking of partitions changed since the last checkpoint.
+		m_grid_dirty{m_grid_isogrid.children().size(), m_grid_isogrid.children().offset()},
+		// Default to lossless encoding of sparse snapshots.
+		m_codec{Codec::raw}, m_quantum{Impl::Sparse::quantum_default}
+	{
+		for (PosIdx pos_idx_child = 0; pos_idx_child < m_grid_isogrid.children().data().size();
+			pos_idx_child++
+		)
+			occupy(pos_idx_child);
+	}
 
 
 	/**
@@ -1241,6 +3007,22 @@ private:
 				}
 			}
 		}
+
+		// Update empty space skipping hierarchy for partitions whose layers have changed.
+		for (TupleIdx layer_idx_from = 0; layer_idx_from < s_num_layers; layer_idx_from++)
+		{
+			for (
+				const PosIdx pos_idx_child :
+				m_grid_status_change.children().lookup().list(layer_idx_from)
+			) {
+				occupy(pos_idx_child);
+				touch(pos_idx_child);
+			}
+		}
+		// Flag partitions whose values have changed for the next checkpoint.
+		for (TupleIdx layer_idx = 0; layer_idx < s_num_layers; layer_idx++)
+			for (const PosIdx pos_idx_child : m_grid_delta.children().lookup().list(layer_idx))
+				touch(pos_idx_child);
 	}
 
 	/**
@@ -1347,6 +3129,8 @@ private:
 							#endif
 
 							this->m_grid_isogrid.track(distance_neigh, pos_neigh_, layer_idx);
+							this->occupy(m_grid_isogrid.pos_idx_child(pos_neigh_));
+							this->touch(m_grid_isogrid.pos_idx_child(pos_neigh_));
 						}
 					);
 				} // End for pos_idx.
@@ -1440,29 +3224,41 @@ private:
 	}
 
 	/**
-	 * Cast a ray to the zero layer within a given child grid.
+	 * Cast a ray to the zero layer along a segment of the ray.
 	 *
-	 * @param pos_origin
-	 * @param dir
-	 * @return NULL_POS if no hit, otherwise interpolated position on zero
-	 * curve.
+	 * @param line_ ray to cast.
+	 * @param t_leaf_ ray parameter to start marching from.
+	 * @param t_exit_ ray parameter at which to stop marching.
+	 * @param march_ method to use to choose the step size between samples.
+	 * @return ray_miss if no hit, otherwise interpolated position on zero curve.
 	 */
 	VecDf ray(
-		VecDf pos_sample, const VecDf& dir, const typename IsoGrid::Child& child
+		const Line& line_, Distance t_leaf_, const Distance t_exit_, const RayMarch march_
 	) const {
-		using Line = Eigen::ParametrizedLine<Distance, D>;
-
-		const Line line_leaf(pos_sample, dir);
-		Distance t_leaf = 0;
+		// Fixed step size to use near the zero-layer.
+		static constexpr Distance step_min = 0.5f;
+		// The isogrid stores a city-block distance, which overestimates the Euclidean distance by
+		// up to a factor of sqrt(D), so scale down to get a safe step size.
+		static const Distance step_scale = 1.0f / std::sqrt(Distance(D));
 
-//		std::cerr << "Child: (" << child.offset().transpose() << ") + (" <<
-//			child.size().transpose() << ")" << std::endl;
+		const VecDf& dir = line_.direction();
 
-		while (child.inside(pos_sample))
+		while (t_leaf_ < t_exit_)
 		{
-			const LayerId layer_id = this->layer_id(pos_sample);
+			VecDf pos_sample = line_.pointAt(t_leaf_);
+			// Interpolated distance at sample point. Partitions that are inactive will give their
+			// background value, i.e. beyond the outermost layer.
+			const Distance dist_sample = m_grid_isogrid.interp(pos_sample);
+			const LayerId layer_id = this->layer_id(dist_sample);
+
+			if (march_ == RayMarch::sphere && std::abs(layer_id) > 1)
+			{
+				// Allow a margin of one unit for error in the stored (interpolated) distance.
+				t_leaf_ += std::max(step_min, (std::abs(dist_sample) - 1.0f) * step_scale);
+				continue;
+			}
 
-//			std::cerr << layer_id << std::endl;
+			t_leaf_ += step_min;
 
 			if (abs(layer_id) == 0)
 			{
@@ -1519,85 +3315,11 @@ private:
 					return pos_sample;
 				}
 			}
-
-			t_leaf += 0.5f;
-
-			pos_sample = line_leaf.pointAt(t_leaf);
-		} // End while inside child grid.
+		} // End while samples along segment.
 
 		return ray_miss;
 	}
 
-	/**
-	 * Cast ray to plane, get child at that point, and track to list if it contains zero-curve.
-	 *
-	 * @param child_hits
-	 * @param line
-	 * @param plane
-	 * @return
-	 */
-	bool ray_check_track_child(
-		std::vector<ChildHit>& child_hits, const Line& line, const Plane& plane
-	) const {
-		const VecDf& pos_intersect =
-			line.intersectionPoint(plane) + line.direction() * Distance(TINY);
-
-		const VecDi& size = m_grid_isogrid.size();
-		const VecDi& offset = m_grid_isogrid.offset();
-		const VecDf& dir = line.direction();
-
-		for (Dim i = 0; i < dir.size(); i++)
-		{
-			if (
-				(dir(i) > 0 && pos_intersect(i) > Distance(size(i))) ||
-				(dir(i) < 0 && pos_intersect(i) < Distance(offset(i)))
-			)
-				return false;
-		}
-
-		if (!m_grid_isogrid.inside(pos_intersect))
-			return true;
-
-		const VecDi& pos_floor = pos_intersect.array().floor().matrix().template cast<NodeIdx>();
-		const PosIdx pos_idx_child = m_grid_isogrid.pos_idx_child(pos_floor);
-
-		if (
-			layer(pos_idx_child, 0).size() ||
-			layer(pos_idx_child, 1).size() || layer(pos_idx_child, -1).size()
-		) {
-			child_hits.push_back(ChildHit(pos_intersect, pos_idx_child));
-		}
-		return true;
-	}
-
-	/**
-	 * Along a given dimension at given position, round up or down to border of next partition.
-	 *
-	 * @param dim dimension e.g. 0 for x, 1 for y.
-	 * @param dir direction along given dimension, eiether -1 or 1.
-	 * @param pos position to round from
-	 * @param part_size size of partition in space to round to.
-	 * @return position of plane
-	 */
-	Distance round_to_next(
-		const Dim dim, const Distance dir, const Distance pos, const VecDi part_size
-	) const {
-		// Real-valued child pos translated to [0, 2*childsize) space.
-		Distance pos_plane_dim =
-			(pos - Distance(m_grid_isogrid.offset()(dim))) / Distance(part_size(dim));
-
-		// Round to next child en route in [0, 2*childsize) space.
-		pos_plane_dim = (dir == -1.0f) ?
-			std::floor(pos_plane_dim) : std::ceil(pos_plane_dim);
-		// Scale back to isogrid grid in [0, 2*fullsize) space.
-		pos_plane_dim *= Distance(m_grid_isogrid.child_size()(dim));
-		// Translate back to isogrid grid in [-fullsize, fullsize) space.
-		pos_plane_dim += Distance(m_grid_isogrid.offset()(dim));
-
-		return pos_plane_dim;
-	}
-
-
 #ifdef FELT_DEBUG_ENABLED
 
 	/**
@@ -1649,6 +3371,95 @@ private:
 	}
 #endif
 
+	/**
+	 * Recursively search a block of the occupancy hierarchy for the nearest zero-layer point.
+	 *
+	 * @param pos_ position to search from.
+	 * @param pos_block_ position of block within level of hierarchy.
+	 * @param level_ level of hierarchy.
+	 * @param dist_sq_nearest_ squared distance to nearest point found so far.
+	 * @param pos_nearest_ nearest point found so far.
+	 */
+	void nearest(
+		const VecDf& pos_, const VecDi& pos_block_, const ListIdx level_,
+		Distance& dist_sq_nearest_, VecDf& pos_nearest_
+	) const {
+		if (!m_pyramid.count(pos_block_, level_))
+			return;
+
+		// Bounds of block in leaf grid space.
+		const VecDi& child_size = m_grid_isogrid.child_size();
+		const NodeIdx block_size = NodeIdx(1) << level_;
+		const VecDi& pos_leaf_lower =
+			m_grid_isogrid.offset() + (pos_block_ * block_size).cwiseProduct(child_size);
+		const VecDi& pos_leaf_upper = (pos_leaf_lower + child_size * block_size).cwiseMin(
+			m_grid_isogrid.offset() + m_grid_isogrid.size()
+		) - VecDi::Constant(1);
+
+		// Closest point within block to search position.
+		const VecDf& pos_block_nearest = pos_.cwiseMax(
+			pos_leaf_lower.template cast<Distance>()
+		).cwiseMin(
+			pos_leaf_upper.template cast<Distance>()
+		);
+
+		if ((pos_block_nearest - pos_).squaredNorm() > dist_sq_nearest_)
+			return;
+
+		if (level_ == 0)
+		{
+			const PosIdx pos_idx_child = m_grid_isogrid.children().index(
+				VecDi{pos_block_ + m_grid_isogrid.children().offset()}
+			);
+			materialise(pos_idx_child);
+			const typename IsoGrid::Child& child = m_grid_isogrid.children().get(pos_idx_child);
+
+			for (const PosIdx pos_idx_leaf : child.lookup().list(layer_idx(0)))
+			{
+				const VecDf& pos_leaf = child.index(pos_idx_leaf).template cast<Distance>();
+				const Distance dist_sq = (pos_leaf - pos_).squaredNorm();
+				if (dist_sq <= dist_sq_nearest_)
+				{
+					dist_sq_nearest_ = dist_sq;
+					pos_nearest_ = pos_leaf;
+				}
+			}
+			return;
+		}
+
+		// Recurse into each of the 2^D sub-blocks at the next finer level.
+		const ListIdx level_sub = level_ - 1;
+		for (PosIdx idx_sub = 0; idx_sub < PosIdx(1 << D); idx_sub++)
+		{
+			VecDi pos_block_sub = pos_block_ * 2;
+			for (Dim axis = 0; axis < D; axis++)
+				pos_block_sub(axis) += NodeIdx((idx_sub >> axis) & 1);
+
+			if (Felt::inside(pos_block_sub, VecDi{VecDi::Zero()}, m_pyramid.size(level_sub)))
+				nearest(pos_, pos_block_sub, level_sub, dist_sq_nearest_, pos_nearest_);
+		}
+	}
+
+	/**
+	 * Update the empty space skipping hierarchy for a spatial partition.
+	 *
+	 * A partition is considered occupied if it has points in layers -1, 0 or +1, since these
+	 * are the only layers that can border the zero-curve.
+	 *
+	 * @param pos_idx_child_ position index of spatial partition.
+	 */
+	void occupy(const PosIdx pos_idx_child_)
+	{
+		const VecDi& pos_child = m_grid_isogrid.children().index(pos_idx_child_) -
+			m_grid_isogrid.children().offset();
+
+		m_pyramid.occupy(
+			pos_child,
+			layer(pos_idx_child_, 0).size() ||
+			layer(pos_idx_child_, 1).size() || layer(pos_idx_child_, -1).size()
+		);
+	}
+
 	/**
 	 * Get reference to a single layer of the narrow band at a given
 	 * spatial partition.
@@ -1691,7 +3502,7 @@ private:
 	 * @param val value to round to give narrow band layer ID.
 	 * @return layer ID that given value should belong to
 	 */
-	LayerId layer_id(const Distance val_) const
+	static LayerId layer_id(const Distance val_)
 	{
 		return boost::math::iround(val_ + std::numeric_limits<Distance>::epsilon());
 	}
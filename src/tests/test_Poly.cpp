@@ -1,3 +1,4 @@
+#include <map>
 #include <Felt/Impl/Poly.hpp>
 #include <Felt/Polys.hpp>
 #include <Felt/Surface.hpp>
@@ -246,9 +247,9 @@ GIVEN("an empty 2D polygonisaton and a 9x9 3-layer surface with 3x3 partitions")
  *
  * Forward declaration.
  */
-template <class Surface>
+template <class Surface, class Child>
 ListIdx assert_partitioned_matches_baseline (
-	const Polys<Surface>& polys_,
+	const Polys<Surface, Child>& polys_,
 	const Impl::Poly::Single<typename Surface::IsoGrid>& poly_
 );
 
@@ -260,6 +261,14 @@ ListIdx assert_partitioned_matches_baseline (
 template <class TSurface>
 Impl::Poly::Single<typename TSurface::IsoGrid> baseline_poly(const TSurface& surface_);
 
+/**
+ * Utility: count cubes (squares in 2D) of the whole isogrid that the zero-curve passes through.
+ *
+ * Forward declaration.
+ */
+template <class TSurface>
+ListIdx num_cubes_crossed(const TSurface& surface_);
+
 
 SCENARIO("Polys")
 {
@@ -469,6 +478,48 @@ GIVEN("an empty 3D polygonisaton and a 15x15x15 3-layer surface with 5x5x5 parti
 					CHECK(polys.children().get(Vec3i(0,0,-1)).vtxs().size() == 5);
 				}
 
+				AND_WHEN("polygonisation is welded")
+				{
+					polys.weld();
+
+					THEN("welded mesh has the same number of vertices as single poly of whole surface")
+					{
+						const Poly& poly = baseline_poly(surface);
+
+						CHECK(polys.vtxs().size() == poly.vtxs().size());
+						CHECK(polys.spxs().size() == poly.spxs().size());
+					}
+
+					THEN("welded simplices match partition simplices")
+					{
+						ListIdx total_spx = 0;
+
+						for (
+							PosIdx pos_idx_child = 0; pos_idx_child < polys.children().data().size();
+							pos_idx_child++
+						) {
+							const Poly& child = polys.children().get(pos_idx_child);
+							if (!child.is_active())
+								continue;
+
+							const std::vector<ListIdx>& vtx_idxs = polys.vtx_idxs(pos_idx_child);
+							REQUIRE(vtx_idxs.size() == child.vtxs().size());
+
+							for (ListIdx vtx_idx = 0; vtx_idx < child.vtxs().size(); vtx_idx++)
+								CHECK(polys.vtxs()[vtx_idxs[vtx_idx]].pos == child.vtxs()[vtx_idx].pos);
+
+							for (const Poly::Simplex& spx : child.spxs())
+							{
+								const Poly::Simplex& spx_weld = polys.spxs()[total_spx++];
+								for (Dim endpoint = 0; endpoint < 3; endpoint++)
+									CHECK(spx_weld.idxs(endpoint) == vtx_idxs[spx.idxs(endpoint)]);
+							}
+						}
+
+						CHECK(polys.spxs().size() == total_spx);
+					}
+				}
+
 
 				AND_WHEN("surface is contracted and polygonised")
 				{
@@ -584,6 +635,54 @@ GIVEN("an empty 3D polygonisaton and a 15x15x15 3-layer surface with 5x5x5 parti
 					CHECK(total_vtx == poly.vtxs().size() + 8 + 2 - 2);
 				}
 			}
+
+			AND_WHEN(
+				"surface is expanded with one 'tip' pushed back into central partition, then"
+				" patched after each update"
+			) {
+				surface.update([](const auto&, const auto&){ return -1.0f; });
+				polys.notify();
+				polys.march(PolyGrid::March::dirty);
+				surface.update([](const auto&, const auto&){ return -0.3f; });
+				polys.notify();
+				polys.march(PolyGrid::March::dirty);
+				surface.update_start();
+				surface.delta(Vec3i(0,-2,0), 1.0f);
+				surface.update_end();
+				polys.notify();
+				polys.march(PolyGrid::March::dirty);
+
+				THEN("poly grid matches single poly of whole surface")
+				{
+					const Poly& poly = baseline_poly(surface);
+					assert_partitioned_matches_baseline(polys, poly);
+
+					ListIdx total_spx = 0;
+					for (const Poly& child : polys.children().data())
+						total_spx += child.spxs().size();
+
+					CHECK(total_spx == poly.spxs().size());
+				}
+
+				AND_WHEN("surface is contracted and patched")
+				{
+					surface.update([](const auto&, const auto&){ return 0.6f; });
+					polys.notify();
+					polys.march(PolyGrid::March::dirty);
+
+					THEN("poly grid matches single poly of whole surface")
+					{
+						const Poly& poly = baseline_poly(surface);
+						assert_partitioned_matches_baseline(polys, poly);
+
+						ListIdx total_spx = 0;
+						for (const Poly& child : polys.children().data())
+							total_spx += child.spxs().size();
+
+						CHECK(total_spx == poly.spxs().size());
+					}
+				}
+			}
 		}
 
 		// Failed originally because of std::vector reinitialisation invalidating references
@@ -681,6 +780,21 @@ GIVEN("an empty 3D polygonisaton and a 15x15x15 3-layer surface with 5x5x5 parti
 					CHECK(total_vtx == poly.vtxs().size() + 12);
 				}
 			}
+
+			AND_WHEN("poly is invalidated and polygonised visiting only zero-layer cubes")
+			{
+				polys.invalidate();
+				polys.march(PolyGrid::March::zero);
+
+				THEN("polygonisation is identical to a full march")
+				{
+					const Poly& poly = baseline_poly(surface);
+					const ListIdx total_vtx =
+						assert_partitioned_matches_baseline(polys, poly);
+
+					CHECK(total_vtx == poly.vtxs().size() + 12);
+				}
+			}
 		}
 	} // End WHEN surface is seeded and expanded.
 } // End GIVEN 15x15x15 3-layer surface with 5x5x5 partitions.
@@ -756,6 +870,708 @@ GIVEN(
 	}
 }
 
+
+GIVEN("a 3D polygonisation with hashed vertex cache of a 15x15x15 surface with 5x5x5 partitions")
+{
+	using Surface = Surface<3, 3>;
+	using IsoGrid = typename Surface::IsoGrid;
+	using PolyGrid = Polys<Surface, Impl::Poly::Hashed<IsoGrid>>;
+	using PolyGridDense = Polys<Surface>;
+
+	// Surface to polygonise.
+	Surface surface{Vec3i{15,15,15}, Vec3i{5,5,5}};
+	// The Poly::Grid to test.
+	PolyGrid polys{surface};
+	// Poly::Grid with dense vertex cache to compare against.
+	PolyGridDense polys_dense{surface};
+
+	surface.seed(Vec3i(0,0,0));
+	surface.update([](const auto&, const auto&){ return -1.0f; });
+
+	WHEN("surface is expanded and polygonised")
+	{
+		surface.update([](const auto&, const auto&){ return -1.0f; });
+		polys.notify();
+		polys.march();
+		polys_dense.notify();
+		polys_dense.march();
+
+		THEN("poly grid matches single poly of whole surface")
+		{
+			const ListIdx total_vtx =
+				assert_partitioned_matches_baseline(polys, baseline_poly(surface));
+			const ListIdx total_vtx_dense =
+				assert_partitioned_matches_baseline(polys_dense, baseline_poly(surface));
+
+			CHECK(total_vtx == total_vtx_dense);
+		}
+
+		AND_WHEN("surface is contracted and patched")
+		{
+			surface.update([](const auto&, const auto&){ return 0.6f; });
+			polys.notify();
+			polys.march(PolyGrid::March::dirty);
+
+			THEN("poly grid matches single poly of whole surface")
+			{
+				assert_partitioned_matches_baseline(polys, baseline_poly(surface));
+			}
+
+			AND_WHEN("poly is invalidated and polygonised")
+			{
+				polys.invalidate();
+				polys.march();
+
+				THEN("poly grid matches single poly of whole surface")
+				{
+					assert_partitioned_matches_baseline(polys, baseline_poly(surface));
+				}
+			}
+		}
+	}
+}
+
+GIVEN("3D polygonisations with different normals policies of a 15x15x15 surface")
+{
+	using Surface = Surface<3, 3>;
+	using PolyGrid = Polys<Surface>;
+	using Child = typename PolyGrid::Child;
+
+	Surface surface{Vec3i{15,15,15}, Vec3i{5,5,5}};
+	PolyGrid polys_eager{surface};
+	PolyGrid polys_lazy{surface, PolyGrid::Normals::lazy};
+	PolyGrid polys_none{surface, PolyGrid::Normals::none};
+
+	surface.seed(Vec3i(0,0,0));
+	surface.update([](const auto&, const auto&){ return -1.0f; });
+	surface.update([](const auto&, const auto&){ return -1.0f; });
+
+	for (PolyGrid* ppolys : {&polys_eager, &polys_lazy, &polys_none})
+	{
+		ppolys->notify();
+		ppolys->march();
+	}
+
+	THEN("all meshes match single poly of whole surface")
+	{
+		assert_partitioned_matches_baseline(polys_eager, baseline_poly(surface));
+		assert_partitioned_matches_baseline(polys_lazy, baseline_poly(surface));
+		assert_partitioned_matches_baseline(polys_none, baseline_poly(surface));
+	}
+
+	THEN("lazy and none policies do not store normals during march")
+	{
+		for (const Child& child : polys_lazy.children().data())
+			for (const auto& vtx : child.vtxs())
+				CHECK(std::isnan(vtx.norm(0)));
+		for (const Child& child : polys_none.children().data())
+			for (const auto& vtx : child.vtxs())
+				CHECK(std::isnan(vtx.norm(0)));
+	}
+
+	WHEN("normals are requested")
+	{
+		ListIdx num_vtxs = 0;
+
+		for (PosIdx pos_idx_child = 0; pos_idx_child < polys_eager.children().data().size();
+			pos_idx_child++
+		) {
+			Child& child_eager = polys_eager.children().get(pos_idx_child);
+			Child& child_lazy = polys_lazy.children().get(pos_idx_child);
+			Child& child_none = polys_none.children().get(pos_idx_child);
+
+			for (ListIdx vtx_idx = 0; vtx_idx < child_eager.vtxs().size(); vtx_idx++)
+			{
+				const Vec3f& norm = child_eager.vtxs()[vtx_idx].norm;
+				CHECK(child_eager.norm(vtx_idx) == norm);
+				CHECK(child_lazy.norm(vtx_idx) == norm);
+				CHECK(child_none.norm(vtx_idx) == norm);
+				num_vtxs++;
+			}
+		}
+
+		THEN("lazy normals are stored but none normals are not")
+		{
+			CHECK(num_vtxs > 0);
+			for (const Child& child : polys_lazy.children().data())
+				for (const auto& vtx : child.vtxs())
+					CHECK(!std::isnan(vtx.norm(0)));
+			for (const Child& child : polys_none.children().data())
+				for (const auto& vtx : child.vtxs())
+					CHECK(std::isnan(vtx.norm(0)));
+		}
+	}
+}
+
+GIVEN("a 3D polygonisation of a 15x15x15 surface with 5x5x5 partitions")
+{
+	using Surface = Surface<3, 3>;
+	using PolyGrid = Polys<Surface>;
+	using Child = typename PolyGrid::Child;
+	using Spans = Impl::Poly::Spans;
+
+	Surface surface{Vec3i{15,15,15}, Vec3i{5,5,5}};
+	PolyGrid polys{surface};
+
+	surface.seed(Vec3i(0,0,0));
+	surface.update([](const auto&, const auto&){ return -1.0f; });
+	surface.update([](const auto&, const auto&){ return -1.0f; });
+	polys.notify();
+	polys.march();
+
+	// Check whether a slot lies within a list of spans.
+	auto spanned = [](const Spans& spans_, const ListIdx idx_) {
+		for (const auto& span : spans_)
+			if (span.begin <= idx_ && idx_ < span.end)
+				return true;
+		return false;
+	};
+
+	THEN("spans of changed partitions cover their whole vertex and simplex arrays")
+	{
+		CHECK(polys.changes().size() > 0);
+
+		for (const PosIdx pos_idx_child : polys.changes())
+		{
+			const Child& child = polys.children().get(pos_idx_child);
+			if (!child.vtxs().size())
+				continue;
+			REQUIRE(child.vtx_spans().size() == 1);
+			CHECK(child.vtx_spans()[0].begin == 0);
+			CHECK(child.vtx_spans()[0].end == child.vtxs().size());
+			REQUIRE(child.spx_spans().size() == 1);
+			CHECK(child.spx_spans()[0].begin == 0);
+			CHECK(child.spx_spans()[0].end == child.spxs().size());
+		}
+	}
+
+	WHEN("surface is contracted and patched")
+	{
+		// Snapshot of vertex and simplex arrays before patching.
+		std::vector<std::vector<typename Child::Vertex>> a_vtxs_before;
+		std::vector<std::vector<typename Child::Simplex>> a_spxs_before;
+		for (const Child& child : polys.children().data())
+		{
+			a_vtxs_before.push_back(child.vtxs());
+			a_spxs_before.push_back(child.spxs());
+		}
+
+		surface.update([](const auto&, const auto&){ return 0.6f; });
+		polys.notify();
+		polys.march(PolyGrid::March::dirty);
+
+		THEN("every modified slot is within a reported span")
+		{
+			ListIdx num_spanned = 0;
+
+			for (const PosIdx pos_idx_child : polys.changes())
+			{
+				const Child& child = polys.children().get(pos_idx_child);
+				const auto& vtxs_before = a_vtxs_before[pos_idx_child];
+				const auto& spxs_before = a_spxs_before[pos_idx_child];
+
+				for (ListIdx vtx_idx = 0; vtx_idx < child.vtxs().size(); vtx_idx++)
+				{
+					if (spanned(child.vtx_spans(), vtx_idx))
+					{
+						num_spanned++;
+						continue;
+					}
+					// Released vertices are no longer referenced, so don't need reporting.
+					if (child.vtx_edges()[vtx_idx] == Felt::null_idx)
+						continue;
+					REQUIRE(vtx_idx < vtxs_before.size());
+					CHECK(child.vtxs()[vtx_idx].pos == vtxs_before[vtx_idx].pos);
+				}
+
+				for (ListIdx spx_idx = 0; spx_idx < child.spxs().size(); spx_idx++)
+				{
+					if (spanned(child.spx_spans(), spx_idx))
+					{
+						num_spanned++;
+						continue;
+					}
+					REQUIRE(spx_idx < spxs_before.size());
+					CHECK(child.spxs()[spx_idx].idxs == spxs_before[spx_idx].idxs);
+				}
+			}
+
+			CHECK(num_spanned > 0);
+		}
+	}
+
+	WHEN("polygonisation is flattened into library-owned buffers")
+	{
+		polys.flatten();
+
+		THEN("flat buffers match child polys with rebased simplex indices")
+		{
+			const auto& flat = polys.flat();
+			ListIdx vtx_offset = 0;
+			ListIdx spx_offset = 0;
+
+			for (const Child& child : polys.children().data())
+			{
+				for (ListIdx vtx_idx = 0; vtx_idx < child.vtxs().size(); vtx_idx++)
+				{
+					const ListIdx flat_idx = (vtx_offset + vtx_idx) * 3;
+					const auto& vtx = child.vtxs()[vtx_idx];
+					CHECK(Vec3f(
+						flat.pos[flat_idx], flat.pos[flat_idx + 1], flat.pos[flat_idx + 2]
+					) == vtx.pos);
+					CHECK(Vec3f(
+						flat.norm[flat_idx], flat.norm[flat_idx + 1], flat.norm[flat_idx + 2]
+					) == vtx.norm);
+				}
+
+				for (ListIdx spx_idx = 0; spx_idx < child.spxs().size(); spx_idx++)
+				{
+					const ListIdx flat_idx = (spx_offset + spx_idx) * 3;
+					for (Dim endpoint = 0; endpoint < 3; endpoint++)
+						CHECK(
+							flat.idxs[flat_idx + endpoint] ==
+								vtx_offset + child.spxs()[spx_idx].idxs(endpoint)
+						);
+				}
+
+				vtx_offset += child.vtxs().size();
+				spx_offset += child.spxs().size();
+			}
+
+			CHECK(vtx_offset > 0);
+			CHECK(flat.pos.size() == vtx_offset * 3);
+			CHECK(flat.norm.size() == vtx_offset * 3);
+			CHECK(flat.idxs.size() == spx_offset * 3);
+		}
+
+		AND_WHEN("polygonisation is flattened into caller-supplied buffers")
+		{
+			polys.flat_offsets();
+			std::vector<Distance> pos(polys.flat_num_vtxs() * 3);
+			std::vector<ListIdx> idxs(polys.flat_num_spxs() * 3);
+			polys.flatten(pos.data(), nullptr, idxs.data());
+
+			THEN("caller-supplied buffers match library-owned buffers")
+			{
+				CHECK(pos == polys.flat().pos);
+				CHECK(idxs == polys.flat().idxs);
+			}
+		}
+
+		AND_WHEN("surface is updated and re-polygonised without recomputing flat offsets")
+		{
+			surface.update([](const auto&, const auto&){ return -1.0f; });
+			polys.notify();
+			polys.march();
+			std::vector<Distance> pos(polys.flat_num_vtxs() * 3);
+			std::vector<ListIdx> idxs(polys.flat_num_spxs() * 3);
+
+			THEN("flattening into caller-supplied buffers throws")
+			{
+				CHECK_THROWS_AS(
+					polys.flatten(pos.data(), nullptr, idxs.data()), const std::domain_error&
+				);
+			}
+		}
+	}
+}
+
+GIVEN("an asynchronous 3D polygonisation of a 15x15x15 surface with 5x5x5 partitions")
+{
+	using Surface = Surface<3, 3>;
+	using PolyGrid = Polys<Surface>;
+
+	// Surface to polygonise.
+	Surface surface{Vec3i{15,15,15}, Vec3i{5,5,5}};
+	// Surface kept one update behind, to check against what was polygonised.
+	Surface surface_behind{Vec3i{15,15,15}, Vec3i{5,5,5}};
+	PolyGrid polys{surface};
+
+	for (Surface* psurface : {&surface, &surface_behind})
+	{
+		psurface->seed(Vec3i(0,0,0));
+		psurface->update([](const auto&, const auto&){ return -1.0f; });
+	}
+	polys.notify();
+	polys.march_async();
+
+	WHEN("surface is updated whilst polygonisation is in progress")
+	{
+		surface.update([](const auto&, const auto&){ return -1.0f; });
+		polys.wait();
+
+		THEN("poly grid matches surface as it was before the update")
+		{
+			assert_partitioned_matches_baseline(polys, baseline_poly(surface_behind));
+		}
+
+		AND_WHEN("the surface is seeded and stamped then invalidated and polygonised")
+		{
+			surface.seed(Vec3i(-4,4,-4));
+			surface.stamp({Surface::Primitive::sphere(Vec3f(4,4,4), 2)});
+			polys.invalidate();
+			polys.march();
+
+			THEN("poly grid matches surface")
+			{
+				assert_partitioned_matches_baseline(polys, baseline_poly(surface));
+			}
+		}
+
+		AND_WHEN("the update is polygonised asynchronously whilst the surface is contracted")
+		{
+			surface_behind.update([](const auto&, const auto&){ return -1.0f; });
+			polys.notify();
+			polys.march_async(PolyGrid::March::dirty);
+			surface.update([](const auto&, const auto&){ return 0.6f; });
+			polys.wait();
+
+			THEN("poly grid matches surface as it was before contraction")
+			{
+				assert_partitioned_matches_baseline(polys, baseline_poly(surface_behind));
+			}
+
+			AND_WHEN("the contraction is polygonised synchronously")
+			{
+				polys.notify();
+				polys.march(PolyGrid::March::dirty);
+
+				THEN("poly grid matches surface")
+				{
+					assert_partitioned_matches_baseline(polys, baseline_poly(surface));
+				}
+			}
+		}
+	}
+}
+
+GIVEN("3D surface nets polygonisation of a 20x20x20 surface with 5x5x5 partitions")
+{
+	using Surface = Surface<3, 3>;
+	using IsoGrid = typename Surface::IsoGrid;
+	using PolyGrid = Polys<Surface, Impl::Poly::Nets<IsoGrid>>;
+
+	Surface surface{Vec3i{20,20,20}, Vec3i{5,5,5}};
+	PolyGrid polys{surface};
+
+	surface.seed(Vec3i(0,0,0));
+	for (ListIdx i = 0; i < 4; i++)
+		surface.update([](const auto&, const auto&){ return -1.0f; });
+	surface.update([](const auto&, const auto&){ return -0.3f; });
+
+	WHEN("surface is polygonised and welded")
+	{
+		polys.invalidate();
+		polys.march();
+		polys.weld();
+
+		THEN("mesh is closed, consistently oriented and outward facing")
+		{
+			REQUIRE(polys.spxs().size() > 0);
+
+			// Count of each directed edge of every triangle.
+			std::map<std::pair<ListIdx, ListIdx>, ListIdx> edge_counts;
+
+			for (const auto& spx : polys.spxs())
+			{
+				const Vec3f& a = polys.vtxs()[spx.idxs(0)].pos;
+				const Vec3f& b = polys.vtxs()[spx.idxs(1)].pos;
+				const Vec3f& c = polys.vtxs()[spx.idxs(2)].pos;
+				CHECK((b - a).cross(c - a).dot((a + b + c) / 3) > 0);
+
+				for (Dim endpoint = 0; endpoint < 3; endpoint++)
+					edge_counts[std::make_pair(
+						ListIdx(spx.idxs(endpoint)), ListIdx(spx.idxs((endpoint + 1) % 3))
+					)]++;
+			}
+
+			for (const auto& edge_count : edge_counts)
+			{
+				INFO(
+					"Edge " + std::to_string(edge_count.first.first) + "-" +
+					std::to_string(edge_count.first.second)
+				);
+				CHECK(edge_count.second == 1);
+				const auto it = edge_counts.find(
+					std::make_pair(edge_count.first.second, edge_count.first.first)
+				);
+				CHECK(it != edge_counts.end());
+			}
+		}
+
+		THEN("there is one vertex per cube crossed by the surface")
+		{
+			CHECK(polys.vtxs().size() == num_cubes_crossed(surface));
+		}
+	}
+}
+
+GIVEN("2D surface nets polygonisation of a 20x20 surface with 5x5 partitions")
+{
+	using Surface = Surface<2, 3>;
+	using IsoGrid = typename Surface::IsoGrid;
+	using PolyGrid = Polys<Surface, Impl::Poly::Nets<IsoGrid>>;
+
+	Surface surface{Vec2i{20,20}, Vec2i{5,5}};
+	PolyGrid polys{surface};
+
+	surface.seed(Vec2i(0,0));
+	for (ListIdx i = 0; i < 4; i++)
+		surface.update([](const auto&, const auto&){ return -1.0f; });
+	surface.update([](const auto&, const auto&){ return -0.3f; });
+
+	WHEN("surface is polygonised and welded")
+	{
+		polys.invalidate();
+		polys.march();
+		polys.weld();
+
+		THEN("curve is closed and consistently oriented, matching marching squares")
+		{
+			REQUIRE(polys.spxs().size() > 0);
+
+			std::vector<ListIdx> num_out(polys.vtxs().size(), 0);
+			std::vector<ListIdx> num_in(polys.vtxs().size(), 0);
+
+			for (const auto& spx : polys.spxs())
+			{
+				const Vec2f& a = polys.vtxs()[spx.idxs(0)].pos;
+				const Vec2f& b = polys.vtxs()[spx.idxs(1)].pos;
+				const Vec2f& d = b - a;
+				const Vec2f& c = (a + b) / 2;
+				CHECK(d(0) * c(1) - d(1) * c(0) < 0);
+				num_out[spx.idxs(0)]++;
+				num_in[spx.idxs(1)]++;
+			}
+
+			for (ListIdx vtx_idx = 0; vtx_idx < polys.vtxs().size(); vtx_idx++)
+			{
+				CHECK(num_out[vtx_idx] == 1);
+				CHECK(num_in[vtx_idx] == 1);
+			}
+		}
+
+		THEN("there is one vertex per square crossed by the curve")
+		{
+			CHECK(polys.vtxs().size() == num_cubes_crossed(surface));
+		}
+	}
+
+	WHEN("a coarser level of detail is requested")
+	{
+		THEN("an exception is thrown and partitions remain at full resolution")
+		{
+			CHECK_THROWS_AS(polys.stride(0, 5), const std::domain_error&);
+			CHECK(polys.stride(0) == 1);
+			CHECK_NOTHROW(polys.stride(0, 1));
+		}
+	}
+}
+
+GIVEN("a 3D polygonisation of a 20x20x20 surface with 10x10x10 partitions")
+{
+	using Surface = Surface<3, 1>;
+	using PolyGrid = Polys<Surface>;
+
+	Surface surface{Vec3i{20,20,20}, Vec3i{10,10,10}};
+	PolyGrid polys{surface};
+
+	// Seed in the middle of a partition, so the narrow band is initially contained within it.
+	surface.seed(Vec3i(-5,-5,-5));
+	surface.update([](const auto&, const auto&){ return -1.0f; });
+	surface.update([](const auto&, const auto&){ return -1.0f; });
+	polys.notify();
+	polys.march();
+
+	THEN("too few partitions changed to polygonise in parallel, and poly grid matches surface")
+	{
+		CHECK(polys.changes().size() == 1);
+		CHECK(polys.changes().size() < FELT_POLYS_OMP_MIN_CHILDS);
+		assert_partitioned_matches_baseline(polys, baseline_poly(surface));
+	}
+
+	WHEN("surface is expanded across many partitions and polygonised")
+	{
+		for (ListIdx i = 0; i < 5; i++)
+			surface.update([](const auto&, const auto&){ return -1.0f; });
+		polys.notify();
+		polys.march();
+
+		THEN("partitions are handed out by decreasing workload, and poly grid matches surface")
+		{
+			const auto& workloads = polys.workloads();
+			REQUIRE(workloads.size() == polys.changes().size());
+			CHECK(workloads.size() >= FELT_POLYS_OMP_MIN_CHILDS);
+
+			for (ListIdx list_idx = 0; list_idx < workloads.size(); list_idx++)
+			{
+				const auto& isochild =
+					surface.isogrid().children().get(workloads[list_idx].second);
+				ListIdx num_leafs = 0;
+				for (TupleIdx layer_idx = 0; layer_idx < 3; layer_idx++)
+					num_leafs += isochild.lookup().list(layer_idx).size();
+
+				CHECK(workloads[list_idx].first == num_leafs);
+				if (list_idx > 0)
+					CHECK(workloads[list_idx - 1].first >= workloads[list_idx].first);
+			}
+			CHECK(workloads.front().first > workloads.back().first);
+
+			assert_partitioned_matches_baseline(polys, baseline_poly(surface));
+		}
+	}
+}
+
+GIVEN("a 3D polygonisation of a 20x20x20 surface with 4x4x4 partitions")
+{
+	using Surface = Surface<3, 3>;
+	using PolyGrid = Polys<Surface>;
+
+	Surface surface{Vec3i{20,20,20}, Vec3i{4,4,4}};
+	PolyGrid polys{surface};
+
+	surface.seed(Vec3i(0,0,0));
+	for (ListIdx i = 0; i < 4; i++)
+		surface.update([](const auto&, const auto&){ return -1.0f; });
+	surface.update([](const auto&, const auto&){ return -0.3f; });
+
+	polys.invalidate();
+	polys.march();
+
+	// Number of simplices and vertex edges of each partition at full resolution.
+	std::vector<ListIdx> num_spxs_full;
+	std::vector<PosIdxList> vtx_edges_full;
+	ListIdx num_spxs_total_full = 0;
+	for (const PolyGrid::Child& child : polys.children().data())
+	{
+		num_spxs_full.push_back(child.spxs().size());
+		vtx_edges_full.push_back(child.vtx_edges());
+		num_spxs_total_full += child.spxs().size();
+	}
+
+	WHEN("an invalid stride is requested")
+	{
+		THEN("an exception is thrown")
+		{
+			CHECK_THROWS_AS(polys.stride(0, 3), const std::domain_error&);
+			CHECK_THROWS_AS(polys.stride(0, 0), const std::domain_error&);
+			CHECK(polys.stride(0) == 1);
+		}
+	}
+
+	WHEN("a level of detail callback returns a zero stride")
+	{
+		THEN("an exception is thrown")
+		{
+			CHECK_THROWS_AS(
+				polys.lod([](const Vec3i&, const Vec3i&) { return NodeIdx(0); }),
+				const std::domain_error&
+			);
+			CHECK(polys.stride(0) == 1);
+		}
+	}
+
+	WHEN("every partition is set to a stride of 2 and marched")
+	{
+		polys.lod([](const Vec3i&, const Vec3i&) { return NodeIdx(2); });
+		polys.march(PolyGrid::March::dirty);
+
+		THEN("every active partition is repolygonised")
+		{
+			ListIdx num_childs_active = 0;
+			for (const PolyGrid::Child& child : polys.children().data())
+				num_childs_active += child.is_active();
+			CHECK(polys.changes().size() == num_childs_active);
+		}
+
+		THEN("vertices lie along edges between grid nodes sampled at the stride")
+		{
+			ListIdx num_spxs_total = 0;
+
+			for (const PolyGrid::Child& child : polys.children().data())
+			{
+				num_spxs_total += child.spxs().size();
+				CHECK(child.stride() == 2);
+
+				for (const PosIdx edge_idx : child.vtx_edges())
+				{
+					if (edge_idx == Felt::null_idx)
+						continue;
+					const Vec3i& pos = child.edge_pos(edge_idx);
+					INFO(Felt::format(pos));
+					for (Dim axis = 0; axis < 3; axis++)
+						CHECK(pos(axis) % 2 == 0);
+				}
+			}
+
+			CHECK(num_spxs_total < num_spxs_total_full);
+		}
+
+		THEN("skirts hang from edges on partition faces")
+		{
+			ListIdx num_vtxs_skirt = 0;
+
+			for (const PolyGrid::Child& child : polys.children().data())
+			{
+				for (ListIdx vtx_idx = 0; vtx_idx < child.vtxs().size(); vtx_idx++)
+				{
+					if (child.vtx_edges()[vtx_idx] != Felt::null_idx)
+						continue;
+					num_vtxs_skirt++;
+
+					// Skirt vertices lie within the plane of a partition face.
+					const Vec3f& pos = child.vtxs()[vtx_idx].pos;
+					bool is_on_face = false;
+					for (Dim axis = 0; axis < 3; axis++)
+						is_on_face |= std::fmod(pos(axis) + 10.0f, 4.0f) == 0;
+					INFO(Felt::format(pos));
+					CHECK(is_on_face);
+				}
+			}
+
+			CHECK(num_vtxs_skirt > 0);
+		}
+
+		AND_WHEN("every partition is set back to a stride of 1 and marched")
+		{
+			polys.lod([](const Vec3i&, const Vec3i&) { return NodeIdx(1); });
+			polys.march(PolyGrid::March::dirty);
+
+			THEN("the polygonisation matches the original full resolution polygonisation")
+			{
+				for (PosIdx pos_idx_child = 0; pos_idx_child < num_spxs_full.size(); pos_idx_child++)
+				{
+					const PolyGrid::Child& child = polys.children().get(pos_idx_child);
+					CHECK(child.spxs().size() == num_spxs_full[pos_idx_child]);
+					CHECK(child.vtx_edges() == vtx_edges_full[pos_idx_child]);
+				}
+			}
+		}
+	}
+
+	WHEN("partitions along the positive x-axis are set to a stride of 2 and marched")
+	{
+		polys.lod([](const Vec3i& pos_, const Vec3i&) { return NodeIdx(pos_(0) >= 0 ? 2 : 1); });
+		polys.march();
+
+		THEN("only coarse partitions containing part of the surface have skirts")
+		{
+			for (PosIdx pos_idx_child = 0; pos_idx_child < polys.children().data().size(); pos_idx_child++)
+			{
+				const PolyGrid::Child& child = polys.children().get(pos_idx_child);
+				if (!child.is_active() || !child.spxs().size())
+					continue;
+				const bool has_skirt = std::find(
+					child.vtx_edges().begin(), child.vtx_edges().end(), Felt::null_idx
+				) != child.vtx_edges().end();
+				const Vec3i& pos_child = surface.isogrid().children().get(pos_idx_child).offset();
+				INFO(Felt::format(pos_child));
+				CHECK(has_skirt == (pos_child(0) >= 0));
+			}
+		}
+	}
+}
+
 }
 
 
@@ -790,11 +1606,53 @@ Impl::Poly::Single<typename TSurface::IsoGrid> baseline_poly(const TSurface& sur
 
 
 /**
- * Utility: assert PolyGrid matches simple Poly polygonisation.
+ * Utility: count cubes (squares in 2D) of the whole isogrid that the zero-curve passes through.
  */
 template <class TSurface>
+ListIdx num_cubes_crossed(const TSurface& surface_)
+{
+	using IsoGrid = typename TSurface::IsoGrid;
+	static constexpr Dim dims = Impl::Traits<IsoGrid>::t_dims;
+	static constexpr PosIdx num_corners = 1 << dims;
+	using VecDi = Felt::VecDi<dims>;
+
+	const IsoGrid& isogrid = surface_.isogrid();
+	const VecDi& size_cubes = isogrid.size() - VecDi::Constant(1);
+	ListIdx num_cubes = 0;
+
+	for (PosIdx pos_idx = 0; pos_idx < PosIdx(size_cubes.prod()); pos_idx++)
+	{
+		VecDi pos_cube;
+		PosIdx pos_idx_axis = pos_idx;
+		for (Dim axis = 0; axis < dims; axis++)
+		{
+			pos_cube(axis) = NodeIdx(pos_idx_axis % size_cubes(axis)) + isogrid.offset()(axis);
+			pos_idx_axis /= size_cubes(axis);
+		}
+
+		ListIdx num_outside = 0;
+		for (PosIdx corner_idx = 0; corner_idx < num_corners; corner_idx++)
+		{
+			VecDi pos_corner = pos_cube;
+			for (Dim axis = 0; axis < dims; axis++)
+				pos_corner(axis) += NodeIdx((corner_idx >> axis) & 1);
+			num_outside += isogrid.get(pos_corner) > 0;
+		}
+
+		if (num_outside != 0 && num_outside != num_corners)
+			num_cubes++;
+	}
+
+	return num_cubes;
+}
+
+
+/**
+ * Utility: assert PolyGrid matches simple Poly polygonisation.
+ */
+template <class TSurface, class TChild>
 ListIdx assert_partitioned_matches_baseline (
-	const Polys<TSurface>& polys_,
+	const Polys<TSurface, TChild>& polys_,
 	const Impl::Poly::Single<typename TSurface::IsoGrid>& poly_
 ) {
 	using IsoGrid = typename TSurface::IsoGrid;
@@ -805,7 +1663,7 @@ ListIdx assert_partitioned_matches_baseline (
 
 	ListIdx total_vtx = 0;
 	ListIdx total_spx = 0;
-	for (const Poly& child : polys_.children().data())
+	for (const TChild& child : polys_.children().data())
 	{
 		total_vtx += child.vtxs().size();
 		total_spx += child.spxs().size();
@@ -822,7 +1680,7 @@ ListIdx assert_partitioned_matches_baseline (
 				+ std::to_string(child.spxs().size())
 			);
 
-		for (const Simplex& polys_spx : child.spxs())
+		for (const auto& polys_spx : child.spxs())
 		{
 			Vec3f polys_vtxs[3];
 			polys_vtxs[0] = child.vtxs()[polys_spx.idxs(0)].pos;
@@ -850,7 +1708,7 @@ ListIdx assert_partitioned_matches_baseline (
 				+ Felt::format(polys_vtxs[2])
 				+ " found in baseline"
 			);
-			CHECK(it != child.spxs().end());
+			CHECK(it != poly_.spxs().end());
 		}
 	}
 
@@ -864,9 +1722,9 @@ ListIdx assert_partitioned_matches_baseline (
 
 		bool found_match = false;
 
-		for (const Poly& child : polys_.children().data())
+		for (const TChild& child : polys_.children().data())
 		{
-			for (const Simplex& polys_spx : child.spxs())
+			for (const auto& polys_spx : child.spxs())
 			{
 				Vec3f polys_vtxs[3];
 				polys_vtxs[0] = child.vtxs()[polys_spx.idxs(0)].pos;
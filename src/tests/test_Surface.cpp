@@ -1,4 +1,5 @@
 #include <fstream>
+#include <sstream>
 #include <unordered_set>
 
 #include "catch.hpp"
@@ -511,6 +512,57 @@ GIVEN("a 2-layer 2D surface in a 9x9 isogrid with 3x3 partitions")
 					}
 				}
 			}
+
+			AND_WHEN("surface is serialised to disk in sparse format then loaded")
+			{
+				std::ofstream ofs{"/tmp/surface.sparse.felt", std::ios::binary};
+				surface.save_sparse(ofs);
+				std::ofstream ofs_dense{"/tmp/surface.felt", std::ios::binary};
+				surface.save(ofs_dense);
+
+				std::ifstream ifs{"/tmp/surface.sparse.felt", std::ios::binary};
+				Surface surface_loaded{Surface::load_sparse(ifs)};
+
+				THEN("isogrid and narrow band layers match")
+				{
+					CHECK(
+						surface.isogrid().snapshot()->data() ==
+							surface_loaded.isogrid().snapshot()->data()
+					);
+					for (LayerId layer_id = -2; layer_id <= 2; layer_id++)
+						CHECK(layer_size(surface_loaded, layer_id) == layer_size(surface, layer_id));
+				}
+
+				THEN("file is smaller than the full serialisation")
+				{
+					CHECK(ofs.tellp() < ofs_dense.tellp());
+				}
+
+				AND_WHEN("loaded surface is updated")
+				{
+					surface_loaded.update([](const auto& pos_, const auto& isogrid_) {
+						(void)pos_; (void)isogrid_;
+						return 0.6f;
+					});
+					surface.update([](const auto& pos_, const auto& isogrid_) {
+						(void)pos_; (void)isogrid_;
+						return 0.6f;
+					});
+
+					THEN("loaded surface is updated in the same way as the original")
+					{
+						CHECK(
+							surface.isogrid().snapshot()->data() ==
+								surface_loaded.isogrid().snapshot()->data()
+						);
+						for (LayerId layer_id = -2; layer_id <= 2; layer_id++)
+							CHECK(
+								layer_size(surface_loaded, layer_id) ==
+									layer_size(surface, layer_id)
+							);
+					}
+				}
+			}
 		} // End WHEN we expand by 0.6
 	}
 }
@@ -576,9 +628,730 @@ GIVEN("a 2-layer 2D surface in a 21x21 isogrid with 2x2 partitions")
 			// But central partition has now been deactivated.
 			CHECK(surface.isogrid().children().get(Vec2i{0,0}).is_active() == false);
 		}
+
+		AND_WHEN("surface is serialised in sparse format then loaded")
+		{
+			std::stringstream stream;
+			surface.save_sparse(stream);
+			Surface surface_loaded{Surface::load_sparse(stream)};
+
+			THEN("isogrid matches, including background of the inactive central partition")
+			{
+				CHECK(
+					surface.isogrid().snapshot()->data() ==
+						surface_loaded.isogrid().snapshot()->data()
+				);
+				CHECK(surface_loaded.isogrid().children().get(Vec2i{0,0}).is_active() == false);
+				CHECK(surface_loaded.isogrid().children().get(Vec2i{0,0}).background() == -3);
+			}
+
+			THEN("partitions are tracked in the same layers")
+			{
+				const auto& lookup = surface.isogrid().children().lookup();
+				const auto& lookup_loaded = surface_loaded.isogrid().children().lookup();
+
+				for (TupleIdx layer_idx = 0; layer_idx < lookup.num_lists; layer_idx++)
+				{
+					PosIdxList pos_idxs = lookup.list(layer_idx);
+					PosIdxList pos_idxs_loaded = lookup_loaded.list(layer_idx);
+					std::sort(pos_idxs.begin(), pos_idxs.end());
+					std::sort(pos_idxs_loaded.begin(), pos_idxs_loaded.end());
+					CHECK(pos_idxs_loaded == pos_idxs);
+				}
+			}
+
+			THEN("a stream of the wrong dimension cannot be loaded")
+			{
+				using Surface3D = Felt::Surface<3, 2>;
+				stream.seekg(0);
+				CHECK_THROWS_AS(Surface3D::load_sparse(stream), const std::domain_error&);
+			}
+
+			THEN("a truncated or corrupt stream cannot be loaded")
+			{
+				const std::string bytes = stream.str();
+
+				std::stringstream stream_truncated{bytes.substr(0, bytes.size() / 2)};
+				CHECK_THROWS_AS(Surface::load_sparse(stream_truncated), const std::domain_error&);
+
+				// Point the first partition table entry beyond the grid.
+				std::string bytes_corrupt = bytes;
+				const std::uint32_t pos_idx_child_bad = 1000;
+				std::memcpy(
+					&bytes_corrupt[Impl::Sparse::align(sizeof(Impl::Sparse::Header<2>))],
+					&pos_idx_child_bad, sizeof(pos_idx_child_bad)
+				);
+				std::stringstream stream_corrupt{bytes_corrupt};
+				CHECK_THROWS_AS(Surface::load_sparse(stream_corrupt), const std::domain_error&);
+			}
+		}
+
+		AND_WHEN("only a bounding box of a sparse snapshot is loaded")
+		{
+			std::stringstream stream;
+			surface.save_sparse(stream);
+			Surface surface_loaded{Surface::load_sparse(stream, Vec2i{-3, -3}, Vec2i{2, 4})};
+			const Surface::IsoGrid& isogrid_loaded = surface_loaded.isogrid();
+
+			THEN("the isogrid covers only the partitions intersecting the box")
+			{
+				CHECK(isogrid_loaded.offset() == Vec2i(-4, -4));
+				CHECK(isogrid_loaded.size() == Vec2i(8, 10));
+				CHECK(isogrid_loaded.children().size() == Vec2i(4, 5));
+			}
+
+			THEN("values and layers match the original surface within the region")
+			{
+				ListIdx num_zero_layer = 0;
+				for (PosIdx pos_idx = 0; pos_idx < PosIdx(isogrid_loaded.size().prod()); pos_idx++)
+				{
+					const Vec2i& pos =
+						Felt::index<2>(pos_idx, isogrid_loaded.size()) + isogrid_loaded.offset();
+					CHECK(isogrid_loaded.get(pos) == surface.isogrid().get(pos));
+					if (surface.isogrid().get(pos) == 0)
+						num_zero_layer++;
+				}
+				CHECK(layer_size(surface_loaded, 0) == num_zero_layer);
+				CHECK(num_zero_layer > 0);
+			}
+
+			THEN("the inactive central partition keeps its inside background")
+			{
+				CHECK(isogrid_loaded.children().get(Vec2i{0,0}).is_active() == false);
+				CHECK(isogrid_loaded.children().get(Vec2i{0,0}).background() == -3);
+			}
+
+			AND_WHEN("a box extending beyond the saved isogrid is loaded")
+			{
+				stream.seekg(0);
+				Surface surface_edge{Surface::load_sparse(stream, Vec2i{5, 5}, Vec2i{100, 100})};
+
+				THEN("the region is clamped to the saved isogrid")
+				{
+					CHECK(surface_edge.isogrid().offset() == Vec2i(4, 4));
+					CHECK(surface_edge.isogrid().size() == Vec2i(7, 7));
+					CHECK(
+						surface_edge.isogrid().get(Vec2i{10, 10}) ==
+							surface.isogrid().get(Vec2i{10, 10})
+					);
+				}
+			}
+
+			THEN("a box outside the saved isogrid cannot be loaded")
+			{
+				stream.seekg(0);
+				CHECK_THROWS_AS(
+					Surface::load_sparse(stream, Vec2i{20, 20}, Vec2i{30, 30}), const std::domain_error&
+				);
+			}
+		}
+
+		AND_WHEN("a base snapshot is saved then checkpoints are appended after further updates")
+		{
+			std::stringstream stream_base;
+			std::stringstream stream_deltas;
+			surface.save_sparse(stream_base);
+			surface.clean();
+			const ListIdx num_dirty_clean = surface.dirty().size();
+
+			surface.update([](const auto&, const auto&) { return -1.0f; });
+			surface.checkpoint(stream_deltas);
+			const ListIdx num_dirty_checkpointed = surface.dirty().size();
+
+			surface.update(Vec2i{0, 0}, Vec2i{10, 10}, [](const auto&, const auto&) {
+				return -1.0f;
+			});
+			const ListIdx num_dirty_local = surface.dirty().size();
+			surface.checkpoint(stream_deltas);
+
+			THEN("only partitions changed by each update are flagged")
+			{
+				CHECK(num_dirty_clean == 0);
+				CHECK(num_dirty_checkpointed == 0);
+				CHECK(num_dirty_local > 0);
+				CHECK(num_dirty_local < surface.stats().active_isogrid_partitions);
+			}
+
+			THEN("applying the checkpoints to the base snapshot reproduces the surface")
+			{
+				Surface surface_loaded{Surface::load_sparse(stream_base, stream_deltas)};
+
+				CHECK(
+					surface.isogrid().snapshot()->data() ==
+						surface_loaded.isogrid().snapshot()->data()
+				);
+				for (LayerId layer_id = -2; layer_id <= 2; layer_id++)
+					CHECK(layer_size(surface_loaded, layer_id) == layer_size(surface, layer_id));
+			}
+
+			THEN("compacting the checkpoints into the base snapshot reproduces the surface")
+			{
+				std::stringstream stream_compacted;
+				Surface::compact(stream_base, stream_deltas, stream_compacted);
+				Surface surface_loaded{Surface::load_sparse(stream_compacted)};
+
+				CHECK(
+					surface.isogrid().snapshot()->data() ==
+						surface_loaded.isogrid().snapshot()->data()
+				);
+			}
+
+			THEN("checkpoints cannot be loaded as a base snapshot")
+			{
+				CHECK_THROWS_AS(Surface::load_sparse(stream_deltas), const std::domain_error&);
+			}
+
+			THEN("checkpoints of a grid with different partitions cannot be applied")
+			{
+				Surface surface_other(Vec2i{21, 21}, Vec2i{3, 3});
+				surface_other.seed(Vec2i{0, 0});
+				std::stringstream stream_deltas_other;
+				surface_other.checkpoint(stream_deltas_other);
+
+				CHECK_THROWS_AS(
+					Surface::load_sparse(stream_base, stream_deltas_other), const std::domain_error&
+				);
+			}
+		}
+	}
+}
+
+
+GIVEN("a 3-layer 3D surface in a 32x32x32 isogrid with 4x4x4 partitions")
+{
+	using Surface = Surface<3, 3>;
+	Surface surface(Vec3i{32, 32, 32}, Vec3i{4, 4, 4});
+
+	surface.seed(Vec3i(0, 0, 0));
+	for (unsigned i = 0; i < 8; i++)
+		surface.update([](const auto&, const auto&) { return -1.0f; });
+
+	WHEN("surface is serialised in sparse format then loaded in parallel")
+	{
+		std::stringstream stream;
+		surface.save_sparse(stream);
+		Surface surface_loaded{Surface::load_sparse(stream)};
+
+		THEN("isogrid and partition tracking match")
+		{
+			CHECK(
+				surface.isogrid().snapshot()->data() == surface_loaded.isogrid().snapshot()->data()
+			);
+
+			const auto& lookup = surface.isogrid().children().lookup();
+			const auto& lookup_loaded = surface_loaded.isogrid().children().lookup();
+
+			for (TupleIdx layer_idx = 0; layer_idx < lookup.num_lists; layer_idx++)
+			{
+				PosIdxList pos_idxs = lookup.list(layer_idx);
+				PosIdxList pos_idxs_loaded = lookup_loaded.list(layer_idx);
+				std::sort(pos_idxs.begin(), pos_idxs.end());
+				std::sort(pos_idxs_loaded.begin(), pos_idxs_loaded.end());
+				CHECK(pos_idxs_loaded == pos_idxs);
+			}
+
+			for (LayerId layer_id = -3; layer_id <= 3; layer_id++)
+				CHECK(layer_size(surface_loaded, layer_id) == layer_size(surface, layer_id));
+		}
+	}
+
+	WHEN("surface is saved in sparse format using the compact codec then loaded")
+	{
+		std::stringstream stream_raw;
+		std::stringstream stream_compact;
+		surface.save_sparse(stream_raw);
+		surface.codec(Surface::Codec::compact);
+		surface.save_sparse(stream_compact);
+		Surface surface_loaded{Surface::load_sparse(stream_compact)};
+
+		THEN("the snapshot is several times smaller than using the raw codec")
+		{
+			INFO(stream_raw.str().size() << " vs " << stream_compact.str().size());
+			CHECK(stream_compact.str().size() * 3 < stream_raw.str().size());
+		}
+
+		THEN("isogrid and layers match")
+		{
+			CHECK(
+				surface.isogrid().snapshot()->data() == surface_loaded.isogrid().snapshot()->data()
+			);
+			for (LayerId layer_id = -3; layer_id <= 3; layer_id++)
+				CHECK(layer_size(surface_loaded, layer_id) == layer_size(surface, layer_id));
+		}
+
+		THEN("a snapshot with a truncated partition payload cannot be loaded")
+		{
+			using Header = Impl::Sparse::Header<3>;
+			using Entry = Impl::Sparse::Entry;
+			std::string bytes = stream_compact.str();
+			Header header;
+			std::memcpy(&header, bytes.data(), sizeof(Header));
+
+			// Shrink the first non-empty payload to a single byte.
+			Entry* entries = reinterpret_cast<Entry*>(&bytes[Impl::Sparse::align(sizeof(Header))]);
+			Entry* pentry = std::find_if(
+				entries, entries + header.num_entries, [](const Entry& entry_) {
+					return entry_.size > 1;
+				}
+			);
+			REQUIRE(pentry != entries + header.num_entries);
+			pentry->size = 1;
+
+			std::stringstream stream_truncated{bytes};
+			CHECK_THROWS_AS(Surface::load_sparse(stream_truncated), const std::domain_error&);
+		}
+
+		AND_WHEN("surface is updated by a fraction then saved using the compact codec")
+		{
+			surface.codec(Surface::Codec::compact, 0.01f);
+			surface.update([](const auto&, const auto&) { return -0.3f; });
+			surface.update([](const auto&, const auto&) { return -0.3f; });
+			std::stringstream stream_fraction;
+			surface.save_sparse(stream_fraction);
+			Surface surface_fraction{Surface::load_sparse(stream_fraction)};
+
+			THEN("values are quantised to within half a step, in the same layers")
+			{
+				const auto& snapshot = surface.isogrid().snapshot();
+				const auto& snapshot_fraction = surface_fraction.isogrid().snapshot();
+				const auto& diff = (snapshot->array() - snapshot_fraction->array()).abs();
+				const Distance diff_max = diff.maxCoeff();
+				CHECK(diff_max > 0);
+				CHECK(diff_max <= 0.005f + 0.0001f);
+
+				for (LayerId layer_id = -3; layer_id <= 3; layer_id++)
+				{
+					CHECK(
+						layer_size(surface_fraction, layer_id) == layer_size(surface, layer_id)
+					);
+				}
+			}
+		}
+	}
+
+	WHEN("surface is saved on a background thread whilst being updated")
+	{
+		std::stringstream stream_expected;
+		std::stringstream stream_async;
+		surface.save_sparse(stream_expected);
+
+		surface.save_async(stream_async);
+		surface.update([](const auto&, const auto&) { return -1.0f; });
+		surface.wait_save();
+
+		THEN("the saved snapshot is of the surface before the update")
+		{
+			CHECK(stream_async.str() == stream_expected.str());
+		}
+
+		AND_WHEN("surface is saved on a background thread again")
+		{
+			std::stringstream stream_expected_updated;
+			std::stringstream stream_async_updated;
+			surface.save_sparse(stream_expected_updated);
+
+			surface.save_async(stream_async_updated);
+			surface.wait_save();
+
+			THEN("the saved snapshot includes the changed partitions")
+			{
+				CHECK(stream_async_updated.str() == stream_expected_updated.str());
+				CHECK(stream_async_updated.str() != stream_expected.str());
+			}
+		}
+	}
+
+	WHEN("surface is saved in sparse format to disk then memory mapped")
+	{
+		{
+			std::ofstream ofs{"/tmp/surface.mapped.felt", std::ios::binary};
+			surface.save_sparse(ofs);
+		}
+		Surface surface_loaded{Surface::load_mapped("/tmp/surface.mapped.felt")};
+
+		const auto& children = surface.isogrid().children();
+		// A zero-layer point and a distant partition on the opposite side of the surface.
+		const PosIdx pos_idx_child_zero = children.lookup().list(3).front();
+		const PosIdx pos_idx_leaf_zero = children.get(pos_idx_child_zero).lookup().list(3).front();
+		const Vec3i& pos_zero = children.get(pos_idx_child_zero).index(pos_idx_leaf_zero);
+		const Vec3i& pos_far = Vec3i{-pos_zero}.cwiseMin(Vec3i::Constant(15));
+		const PosIdx pos_idx_child_far = surface.isogrid().pos_idx_child(pos_far);
+		INFO(Felt::format(pos_zero) << " " << Felt::format(pos_far));
+		REQUIRE(children.get(pos_idx_child_far).is_active());
+
+		THEN("no active partitions are materialised")
+		{
+			for (PosIdx pos_idx_child = 0; pos_idx_child < children.data().size(); pos_idx_child++)
+			{
+				CHECK(
+					surface_loaded.is_materialised(pos_idx_child) ==
+						!children.get(pos_idx_child).is_active()
+				);
+				CHECK(
+					surface_loaded.isogrid().children().get(pos_idx_child).is_active() == false
+				);
+			}
+		}
+
+		THEN("a truncated file cannot be mapped")
+		{
+			std::stringstream stream;
+			surface.save_sparse(stream);
+			const std::string bytes = stream.str();
+			{
+				std::ofstream ofs{"/tmp/surface.truncated.felt", std::ios::binary};
+				ofs << bytes.substr(0, bytes.size() / 2);
+			}
+			CHECK_THROWS_AS(
+				Surface::load_mapped("/tmp/surface.truncated.felt"), const std::domain_error&
+			);
+		}
+
+		AND_WHEN("a value is queried")
+		{
+			const Distance dist = surface_loaded.get(pos_zero);
+
+			THEN("only the partition containing it is materialised")
+			{
+				CHECK(dist == surface.isogrid().get(pos_zero));
+				CHECK(surface_loaded.is_materialised(pos_idx_child_zero));
+				CHECK(!surface_loaded.is_materialised(pos_idx_child_far));
+				CHECK(surface_loaded.isogrid().children().lookup().is_tracked(pos_idx_child_zero, 3));
+			}
+		}
+
+		AND_WHEN("a ray is cast")
+		{
+			const Vec3f& pos_hit = surface_loaded.ray(Vec3f{0, 0, -20}, Vec3f{0, 0, 1});
+
+			THEN("the hit matches the original surface")
+			{
+				CHECK(pos_hit == surface.ray(Vec3f{0, 0, -20}, Vec3f{0, 0, 1}));
+				CHECK(pos_hit != Surface::ray_miss);
+			}
+		}
+
+		AND_WHEN("a bounded region of both surfaces is updated")
+		{
+			const auto fn = [](const auto&, const auto&) { return -1.0f; };
+			surface.update(Vec3i{pos_zero}, Vec3i{pos_zero + Vec3i::Constant(2)}, fn);
+			surface_loaded.update(Vec3i{pos_zero}, Vec3i{pos_zero + Vec3i::Constant(2)}, fn);
+
+			THEN("distant partitions are not materialised")
+			{
+				CHECK(!surface_loaded.is_materialised(pos_idx_child_far));
+			}
+
+			AND_WHEN("the remaining partitions are materialised")
+			{
+				surface_loaded.materialise();
+
+				THEN("isogrid and layers match the original surface")
+				{
+					CHECK(
+						surface.isogrid().snapshot()->data() ==
+							surface_loaded.isogrid().snapshot()->data()
+					);
+					for (LayerId layer_id = -3; layer_id <= 3; layer_id++)
+					{
+						CHECK(
+							layer_size(surface_loaded, layer_id) == layer_size(surface, layer_id)
+						);
+					}
+				}
+			}
+		}
 	}
 }
 
+GIVEN("a 3-layer 3D surface in a 32x32x32 isogrid with 4x4x4 partitions and a sphere SDF")
+{
+	using Surface = Surface<3, 3>;
+	Surface surface(Vec3i{32, 32, 32}, Vec3i{4, 4, 4});
+	const auto sdf = [](const Vec3i& pos_) { return pos_.template cast<Distance>().norm() - 10; };
+
+	WHEN("the surface is built from the SDF")
+	{
+		surface.build(sdf);
+
+		THEN("narrow band points hold the SDF and are tracked in the corresponding layer")
+		{
+			const auto& children = surface.isogrid().children();
+			ListIdx num_leafs = 0;
+
+			for (LayerId layer_id = -3; layer_id <= 3; layer_id++)
+			{
+				const TupleIdx layer_idx = surface.layer_idx(layer_id);
+				for (const PosIdx pos_idx_child : children.lookup().list(layer_idx))
+				{
+					const auto& child = children.get(pos_idx_child);
+					for (const PosIdx pos_idx_leaf : child.lookup().list(layer_idx))
+					{
+						const Vec3i& pos = child.index(pos_idx_leaf);
+						CHECK(child.get(pos_idx_leaf) == Approx(sdf(pos)));
+						CHECK(std::lround(sdf(pos)) == layer_id);
+						num_leafs++;
+					}
+				}
+				CHECK(layer_size(surface, layer_id) > 0);
+			}
+			CHECK(num_leafs > 0);
+		}
+
+		THEN("partitions not touching the narrow band are inactive")
+		{
+			const auto& children = surface.isogrid().children();
+			const auto& child_centre = children.get(
+				surface.isogrid().pos_idx_child(Vec3i(0, 0, 0))
+			);
+			const auto& child_far = children.get(
+				surface.isogrid().pos_idx_child(Vec3i(-16, -16, -16))
+			);
+
+			CHECK(!child_centre.is_active());
+			CHECK(child_centre.background() == -4);
+			CHECK(!child_far.is_active());
+			CHECK(child_far.background() == 4);
+			CHECK(surface.isogrid().get(Vec3i(1, 1, 1)) == -4);
+			CHECK(surface.isogrid().get(Vec3i(15, 15, 15)) == 4);
+		}
+
+		THEN("a ray hits the sphere")
+		{
+			const Vec3f& pos_hit = surface.ray(Vec3f{0, 0, -20}, Vec3f{0, 0, 1});
+			CHECK(pos_hit(2) == Approx(-10).epsilon(0.01));
+		}
+
+		AND_WHEN("the surface is built from a dense volume sampling the SDF")
+		{
+			Surface surface_volume(Vec3i{32, 32, 32}, Vec3i{4, 4, 4});
+			Impl::Grid::Snapshot<Distance, 3> volume(
+				Vec3i{32, 32, 32}, Vec3i{-16, -16, -16}, 0
+			);
+			for (PosIdx pos_idx = 0; pos_idx < volume.data().size(); pos_idx++)
+				volume.set(pos_idx, sdf(volume.index(pos_idx)));
+
+			surface_volume.build(volume);
+
+			THEN("the isogrid matches the surface built from the SDF")
+			{
+				auto psnapshot = surface.isogrid().snapshot();
+				auto psnapshot_volume = surface_volume.isogrid().snapshot();
+				CHECK(psnapshot_volume->data() == psnapshot->data());
+
+				for (LayerId layer_id = -3; layer_id <= 3; layer_id++)
+					CHECK(layer_size(surface_volume, layer_id) == layer_size(surface, layer_id));
+			}
+		}
+
+		AND_WHEN("the surface is expanded")
+		{
+			surface.update([](const auto&, const auto&) { return -1.0f; });
+
+			THEN("the zero layer moves outward")
+			{
+				const Vec3f& pos_hit = surface.ray(Vec3f{0, 0, -20}, Vec3f{0, 0, 1});
+				CHECK(pos_hit(2) == Approx(-11).epsilon(0.01));
+				CHECK(surface.isogrid().get(Vec3i(0, 0, -11)) == Approx(0));
+			}
+		}
+	}
+}
+
+GIVEN("a 3-layer 3D surface in a 32x32x32 isogrid with 4x4x4 partitions")
+{
+	using Surface = Surface<3, 3>;
+	using Primitive = Surface::Primitive;
+	Surface surface(Vec3i{32, 32, 32}, Vec3i{4, 4, 4});
+
+	const std::vector<Primitive> primitives{
+		Primitive::sphere(Vec3f{-5, 0, 0}, 4),
+		Primitive::sphere(Vec3f{-1, 1, 0}, 3.5f),
+		Primitive::box(Vec3f{2, -3, -2}, Vec3f{9, 3, 4}),
+		Primitive::point(Vec3i{8, 8, 8}),
+		Primitive::sphere(Vec3f{100, 0, 0}, 4)
+	};
+	const auto sdf = [&primitives](const Vec3i& pos_) {
+		Distance dist = std::numeric_limits<Distance>::max();
+		for (const Primitive& primitive : primitives)
+			dist = std::min(dist, primitive.distance(pos_));
+		return dist;
+	};
+
+	WHEN("a single point is stamped")
+	{
+		Surface surface_seed(Vec3i{32, 32, 32}, Vec3i{4, 4, 4});
+		surface_seed.seed(Vec3i{1, 2, 3});
+		surface.stamp({Primitive::point(Vec3i{1, 2, 3})});
+
+		THEN("the surface matches a seeded surface")
+		{
+			auto psnapshot = surface.isogrid().snapshot();
+			auto psnapshot_seed = surface_seed.isogrid().snapshot();
+			CHECK(psnapshot->data() == psnapshot_seed->data());
+
+			for (LayerId layer_id = -3; layer_id <= 3; layer_id++)
+				CHECK(layer_size(surface, layer_id) == layer_size(surface_seed, layer_id));
+		}
+	}
+
+	WHEN("overlapping primitives are stamped in one batch")
+	{
+		Surface surface_built(Vec3i{32, 32, 32}, Vec3i{4, 4, 4});
+		surface_built.build(sdf);
+		surface.stamp(primitives);
+
+		THEN("the surface matches one built from the union of their SDFs")
+		{
+			auto psnapshot = surface.isogrid().snapshot();
+			auto psnapshot_built = surface_built.isogrid().snapshot();
+			CHECK(psnapshot->data() == psnapshot_built->data());
+
+			for (LayerId layer_id = -3; layer_id <= 3; layer_id++)
+			{
+				CHECK(layer_size(surface, layer_id) == layer_size(surface_built, layer_id));
+				CHECK(layer_size(surface, layer_id) > 0);
+			}
+			CHECK(surface.isogrid().get(Vec3i(-5, 0, 0)) == -4);
+		}
+
+		AND_WHEN("the surface is expanded")
+		{
+			surface.update([](const auto&, const auto&) { return -1.0f; });
+
+			THEN("the zero layer moves outward")
+			{
+				const Vec3f& pos_hit = surface.ray(Vec3f{-20, 0, 0}, Vec3f{1, 0, 0});
+				CHECK(pos_hit(0) == Approx(-10).epsilon(0.01));
+			}
+		}
+	}
+
+	WHEN("primitives are stamped over an existing surface")
+	{
+		const Primitive sphere = Primitive::sphere(Vec3f{0, 0, 0}, 7);
+		surface.build([&sphere](const Vec3i& pos_) { return sphere.distance(pos_); });
+		surface.stamp(primitives);
+
+		Surface surface_built(Vec3i{32, 32, 32}, Vec3i{4, 4, 4});
+		surface_built.build([&sphere, &sdf](const Vec3i& pos_) {
+			return std::min(sphere.distance(pos_), sdf(pos_));
+		});
+
+		THEN("the surface matches one built from the union of all SDFs")
+		{
+			auto psnapshot = surface.isogrid().snapshot();
+			auto psnapshot_built = surface_built.isogrid().snapshot();
+			CHECK(psnapshot->data() == psnapshot_built->data());
+
+			for (LayerId layer_id = -3; layer_id <= 3; layer_id++)
+				CHECK(layer_size(surface, layer_id) == layer_size(surface_built, layer_id));
+		}
+	}
+
+	WHEN("a box is constructed with its corners reversed")
+	{
+		THEN("an exception is thrown")
+		{
+			CHECK_THROWS_AS(
+				Primitive::box(Vec3f{1, 1, 1}, Vec3f{0, 2, 2}), const std::domain_error&
+			);
+		}
+	}
+}
+
+GIVEN("two 3-layer 3D surfaces of overlapping spheres in 32x32x32 isogrids with 4x4x4 partitions")
+{
+	using Surface = Surface<3, 3>;
+	using Primitive = Surface::Primitive;
+	const Primitive sphere = Primitive::sphere(Vec3f{-3, 0, 0}, 6);
+	const Primitive sphere_other = Primitive::sphere(Vec3f{4, 1, 0}, 5);
+	const auto sdf = [&sphere](const Vec3i& pos_) { return sphere.distance(pos_); };
+	const auto sdf_other = [&sphere_other](const Vec3i& pos_) {
+		return sphere_other.distance(pos_);
+	};
+
+	Surface surface(Vec3i{32, 32, 32}, Vec3i{4, 4, 4});
+	Surface surface_other(Vec3i{32, 32, 32}, Vec3i{4, 4, 4});
+	Surface surface_expected(Vec3i{32, 32, 32}, Vec3i{4, 4, 4});
+	surface.build(sdf);
+	surface_other.build(sdf_other);
+
+	const auto check_matches = [&surface, &surface_expected]() {
+		auto psnapshot = surface.isogrid().snapshot();
+		auto psnapshot_expected = surface_expected.isogrid().snapshot();
+		CHECK(psnapshot->data() == psnapshot_expected->data());
+
+		for (LayerId layer_id = -3; layer_id <= 3; layer_id++)
+			CHECK(layer_size(surface, layer_id) == layer_size(surface_expected, layer_id));
+	};
+
+	WHEN("the union of the surfaces is taken")
+	{
+		surface.unite(surface_other);
+		surface_expected.build([&sdf, &sdf_other](const Vec3i& pos_) {
+			return std::min(sdf(pos_), sdf_other(pos_));
+		});
+
+		THEN("the surface matches one built from the union of the SDFs")
+		{
+			check_matches();
+			CHECK(!surface.isogrid().children().get(
+				surface.isogrid().pos_idx_child(Vec3i(-16, -16, -16))
+			).is_active());
+		}
+
+		AND_WHEN("the surface is expanded")
+		{
+			surface.update([](const auto&, const auto&) { return -1.0f; });
+
+			THEN("the zero layer moves outward")
+			{
+				const Vec3f& pos_hit = surface.ray(Vec3f{20, 1, 0}, Vec3f{-1, 0, 0});
+				CHECK(pos_hit(0) == Approx(10).epsilon(0.01));
+			}
+		}
+	}
+
+	WHEN("the intersection of the surfaces is taken")
+	{
+		surface.intersect(surface_other);
+		surface_expected.build([&sdf, &sdf_other](const Vec3i& pos_) {
+			return std::max(sdf(pos_), sdf_other(pos_));
+		});
+
+		THEN("the surface matches one built from the intersection of the SDFs")
+		{
+			check_matches();
+			CHECK(layer_size(surface, 0) > 0);
+		}
+	}
+
+	WHEN("the other surface is subtracted")
+	{
+		surface.subtract(surface_other);
+		surface_expected.build([&sdf, &sdf_other](const Vec3i& pos_) {
+			return std::max(sdf(pos_), -sdf_other(pos_));
+		});
+
+		THEN("the surface matches one built from the difference of the SDFs")
+		{
+			check_matches();
+			CHECK(surface.isogrid().get(Vec3i(4, 1, 0)) == 4);
+			CHECK(surface.isogrid().get(Vec3i(-5, 0, 0)) == -4);
+		}
+	}
+
+	WHEN("a surface with a different layout is combined")
+	{
+		Surface surface_bad(Vec3i{32, 32, 32}, Vec3i{8, 8, 8});
+
+		THEN("an exception is thrown")
+		{
+			CHECK_THROWS_AS(surface.unite(surface_bad), const std::domain_error&);
+		}
+	}
+}
 } // End SCENARIO Surface - global up
 
 
@@ -1531,10 +2304,230 @@ GIVEN(
 			check(Vec3f(0, 1, 1).normalized());
 		}
 	}
+
+	AND_WHEN("we rotate around the surface casting rays with both fixed and sphere-traced steps")
+	{
+		using Matrix = Eigen::Matrix3f;
+		using RayMarch = Surface<3, 3>::RayMarch;
+
+		THEN("the hit positions are on the zero-curve and close to each other")
+		{
+			for (Distance rot_mult = 0; rot_mult < 2.0f; rot_mult += 0.1f)
+			{
+				const Matrix mat_rot = Eigen::AngleAxisf(
+					rot_mult * Distance(M_PI), Vec3f(1, 1, 1).normalized()
+				).matrix();
+				const Vec3f origin = mat_rot*Vec3f(0, 0, -10.0f);
+				const Vec3f dir = (mat_rot*Vec3f(0, 0, 1)).normalized();
+
+				// ==== Action ====
+				const Vec3f& pos_hit_fixed = surface.ray(origin, dir, RayMarch::fixed);
+				const Vec3f& pos_hit_sphere = surface.ray(origin, dir, RayMarch::sphere);
+
+				// ==== Confirm ====
+				INFO("Ray from " + Felt::format(origin) + " in direction " + Felt::format(dir));
+				REQUIRE(pos_hit_fixed != surface.ray_miss);
+				REQUIRE(pos_hit_sphere != surface.ray_miss);
+				CHECK(surface.isogrid().interp(pos_hit_fixed) == Approx(0).margin(0.01));
+				CHECK(surface.isogrid().interp(pos_hit_sphere) == Approx(0).margin(0.01));
+				CHECK((pos_hit_sphere - pos_hit_fixed).norm() < 0.25f);
+			}
+		}
+	}
+}
+
+GIVEN("a 2-layer surface of radius 3 in a 16x16 grid with 3x3 partitions")
+{
+	Surface<2, 2> surface(Vec2i(16, 16), Vec2i(3, 3));
+
+	// Create seed point and expand the narrow band.
+	surface.seed(Vec2i(0, 0));
+	surface.update([]() {
+		return -1.0f;
+	});
+	surface.update([]() {
+		return -1.0f;
+	});
+	surface.update([]() {
+		return -1.0f;
+	});
+
+	INFO(stringify_grid_slice(surface.isogrid()));
+
+	WHEN("we cast a ray leftward from far outside the grid")
+	{
+		const Vec2f& pos_hit = surface.ray(Vec2f(100.0f, 0), Vec2f(-1, 0));
+
+		THEN("the surface is hit where expected")
+		{
+			CHECK(pos_hit == ApproxVec(Vec2f(3, 0)).epsilon(0.1));
+		}
+	}
+
+	WHEN("we cast a ray that passes alongside the surface")
+	{
+		const Vec2f& pos_hit = surface.ray(Vec2f(-100.0f, 6.5f), Vec2f(1, 0));
+
+		THEN("the surface is not hit")
+		{
+			CHECK(pos_hit == surface.ray_miss);
+		}
+	}
+
+	WHEN("we cast a ray that does not intersect the grid")
+	{
+		const Vec2f& pos_hit = surface.ray(Vec2f(-100.0f, 0), Vec2f(-1, 0));
+
+		THEN("the surface is not hit")
+		{
+			CHECK(pos_hit == surface.ray_miss);
+		}
+	}
+
+	WHEN("we cast a ray diagonally through the corner of a partition")
+	{
+		const Vec2f& pos_hit = surface.ray(Vec2f(-8.0f, -8.0f), Vec2f(1, 1).normalized());
+
+		THEN("the surface is hit where expected")
+		{
+			CHECK(pos_hit == ApproxVec(Vec2f(-1.5f, -1.5f)).epsilon(0.1));
+		}
+	}
 }
 } // End SCENARIO Surface - raycasting
 
 
+SCENARIO("Surface - nearest")
+{
+GIVEN("a 2-layer surface of radius 3 in a 32x32 grid with 3x3 partitions")
+{
+	Surface<2, 2> surface(Vec2i(32, 32), Vec2i(3, 3));
+
+	// Create seed point and expand the narrow band.
+	surface.seed(Vec2i(0, 0));
+	surface.update([]() {
+		return -1.0f;
+	});
+	surface.update([]() {
+		return -1.0f;
+	});
+	surface.update([]() {
+		return -1.0f;
+	});
+
+	WHEN("we search for the nearest zero-layer point from outside the surface")
+	{
+		const Vec2f& pos_nearest = surface.nearest(Vec2f(10.0f, 0.4f), 20.0f);
+
+		THEN("the nearest point is found")
+		{
+			CHECK(pos_nearest == ApproxVec(Vec2f(3, 0)));
+		}
+	}
+
+	WHEN("we search for the nearest zero-layer point from inside the surface")
+	{
+		const Vec2f& pos_nearest = surface.nearest(Vec2f(0.2f, 1.8f), 20.0f);
+
+		THEN("the nearest point is found")
+		{
+			CHECK(pos_nearest == ApproxVec(Vec2f(1, 2)));
+		}
+	}
+
+	WHEN("we search for the nearest zero-layer point with too small a radius")
+	{
+		const Vec2f& pos_nearest = surface.nearest(Vec2f(10.0f, 0.4f), 5.0f);
+
+		THEN("no point is found")
+		{
+			CHECK(pos_nearest == surface.ray_miss);
+		}
+	}
+
+	AND_WHEN("the surface is contracted until it disappears")
+	{
+		for (int i = 0; i < 5; i++)
+			surface.update([]() {
+				return 1.0f;
+			});
+
+		THEN("no point is found")
+		{
+			CHECK(surface.nearest(Vec2f(0, 0), 100.0f) == surface.ray_miss);
+		}
+
+		THEN("a ray does not hit")
+		{
+			CHECK(surface.ray(Vec2f(-20.0f, 0), Vec2f(1, 0)) == surface.ray_miss);
+		}
+	}
+}
+}
+
+
+SCENARIO("Surface - closest point queries")
+{
+GIVEN("a 2-layer surface of radius 3 in a 32x32 grid with 3x3 partitions")
+{
+	using SurfaceType = Surface<2, 2>;
+	SurfaceType surface(Vec2i(32, 32), Vec2i(3, 3));
+
+	// Create seed point and expand the narrow band.
+	surface.seed(Vec2i(0, 0));
+	surface.update([]() {
+		return -1.0f;
+	});
+	surface.update([]() {
+		return -1.0f;
+	});
+	surface.update([]() {
+		return -1.0f;
+	});
+
+	WHEN("we query a batch of positions")
+	{
+		const std::vector<SurfaceType::Closest>& results = surface.closest({
+			Vec2f(4.5f, 0), Vec2f(0, -2.0f), Vec2f(12.0f, 12.0f), Vec2f(-100.0f, 0), Vec2f(4.0f, 0)
+		});
+
+		THEN("a result is given for each position")
+		{
+			CHECK(results.size() == 5);
+		}
+
+		THEN("positions within the narrow band report distance, normal and closest point")
+		{
+			CHECK(results[0].is_in_band);
+			CHECK(results[0].distance == Approx(1.5f));
+			CHECK(results[0].normal == ApproxVec(Vec2f(1, 0)));
+			CHECK(results[0].pos == ApproxVec(Vec2f(3, 0)));
+
+			CHECK(results[1].is_in_band);
+			CHECK(results[1].distance == Approx(-1.0f));
+			CHECK(results[1].normal == ApproxVec(Vec2f(0, -1)));
+			CHECK(results[1].pos == ApproxVec(Vec2f(0, -3)));
+
+			CHECK(results[4].is_in_band);
+			CHECK(results[4].distance == Approx(1.0f));
+			CHECK(results[4].pos == ApproxVec(Vec2f(3, 0)));
+		}
+
+		THEN("positions in inactive partitions or outside the grid are beyond the narrow band")
+		{
+			CHECK(!results[2].is_in_band);
+			CHECK(results[2].distance == 3.0f);
+			CHECK(results[2].pos == surface.ray_miss);
+
+			CHECK(!results[3].is_in_band);
+			CHECK(results[3].distance == 3.0f);
+			CHECK(results[3].pos == surface.ray_miss);
+		}
+	}
+}
+}
+
+
 SCENARIO("Surface - stats")
 {
 